@@ -0,0 +1,28 @@
+#ifndef BENCH_TIMER_HPP
+#define BENCH_TIMER_HPP
+
+#include <chrono>
+
+namespace BenchTimer {
+    /**
+     * Time a function, repeating it until min_time has elapsed.
+     * @param function The work to measure
+     * @param min_time Minimum total measuring time in seconds
+     * @return Seconds per call
+     */
+    template <typename Function>
+    double timeIt(Function function, double min_time) {
+        using Clock = std::chrono::steady_clock;
+        int calls = 0;
+        auto start = Clock::now();
+        double elapsed = 0;
+        do {
+            function();
+            ++calls;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < min_time);
+        return elapsed / calls;
+    }
+}
+
+#endif // BENCH_TIMER_HPP
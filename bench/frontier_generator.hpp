@@ -0,0 +1,62 @@
+#ifndef FRONTIER_GENERATOR_HPP
+#define FRONTIER_GENERATOR_HPP
+
+#include <random>
+#include "../include/equation_system.hpp"
+
+/**
+ * Synthetic frontier systems for the elimination benchmarks.
+ *
+ * Models a board strip BENCH_STRIP_HEIGHT cells tall in which columns
+ * alternate between revealed numbers and unrevealed cells. Every unrevealed
+ * column is constrained by the number columns on both sides, so the whole
+ * system is one connected component, as on a large open board.
+ */
+namespace FrontierGenerator {
+    constexpr int BENCH_STRIP_HEIGHT = 16;
+
+    /**
+     * Generate a consistent frontier system.
+     * @param unknowns Approximate number of unknowns (rounded up to a whole column)
+     * @param density Probability that an unknown is a mine
+     * @param seed Random seed
+     * @return One equation per number cell that touches an unknown
+     */
+    inline EquationSystem strip(int unknowns, double density, unsigned seed) {
+        const int height = BENCH_STRIP_HEIGHT;
+        const int unknown_columns = (unknowns + height - 1) / height;
+
+        std::mt19937 rng(seed);
+        std::bernoulli_distribution is_mine(density);
+        std::vector<int> mines(unknown_columns * height);
+        for (auto& mine : mines) {
+            mine = is_mine(rng) ? 1 : 0;
+        }
+
+        // Number column k sits between unknown columns k - 1 and k
+        EquationSystem system(unknown_columns * height);
+        for (int k = 0; k <= unknown_columns; ++k) {
+            for (int r = 0; r < height; ++r) {
+                int rhs = 0;
+                bool any = false;
+                for (int column : {k - 1, k}) {
+                    if (column < 0 || column >= unknown_columns) continue;
+                    for (int dr = -1; dr <= 1; ++dr) {
+                        int nr = r + dr;
+                        if (nr < 0 || nr >= height) continue;
+                        int variable = column * height + nr;
+                        system.addTerm(variable, 1);
+                        rhs += mines[variable];
+                        any = true;
+                    }
+                }
+                if (any) {
+                    system.finishEquation(rhs);
+                }
+            }
+        }
+        return system;
+    }
+}
+
+#endif // FRONTIER_GENERATOR_HPP
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../src/minesweeper_class.hpp"
+#include "../src/minesweeper_solver.hpp"
+
+/**
+ * Headless benchmark of the whole solver on seeded games.
+ *
+ * Every game opens the centre cell and then calls MinesweeperSolver::solve
+ * until it makes no more progress. With --guess, every game is instead one
+ * MinesweeperSolver::solveUntilStuck() call that guesses the safest cell
+ * whenever nothing is certain, and the latency columns are per game. Game g of a suite uses seed base + g, so
+ * two runs with the same options play the same boards. Each suite also
+ * reports the solver's per-tier counters from AdaptiveScheduler.
+ *
+ * Usage: game_bench [--suites beginner,intermediate,expert,huge,RxCxM] [--games N]
+ *                   [--seed S] [--json FILE|-] [--guess]
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Suite {
+    std::string name;
+    int rows;
+    int cols;
+    int mines;
+    int games;  // Default game count; --games overrides it for every suite
+};
+
+struct Options {
+    std::vector<Suite> suites;
+    int games = 0;          // 0 keeps each suite's default
+    uint64_t seed = 1;
+    std::string json_path;  // Empty for text only, "-" for stdout
+    bool guess = false;     // Play through solveUntilStuck() with guessing
+};
+
+struct Result {
+    Suite suite;
+    int won = 0;
+    int lost = 0;                     // Games that hit a mine (only when guessing)
+    long steps = 0;                   // solve() calls (tier runs when guessing) that made progress
+    std::vector<double> call_seconds; // Every solve() call, including the last one; every game when guessing
+    double wall_seconds = 0;          // Board generation included
+    std::array<AdaptiveScheduler::Counters, AdaptiveScheduler::TIER_COUNT> tiers{};
+};
+
+bool findSuite(const std::string& name, Suite& suite) {
+    static const Suite standard[] = {
+        {"beginner", 9, 9, 10, 10000},
+        {"intermediate", 16, 16, 40, 5000},
+        {"expert", 16, 30, 99, 2000},
+        {"huge", 256, 256, 13107, 20},  // Expert density
+    };
+    for (const Suite& candidate : standard) {
+        if (candidate.name == name) {
+            suite = candidate;
+            return true;
+        }
+    }
+    // Custom size: RxCxM
+    int rows, cols, mines;
+    if (std::sscanf(name.c_str(), "%dx%dx%d", &rows, &cols, &mines) == 3 && rows > 0 && cols > 0) {
+        suite = {name, rows, cols, mines, 100};
+        return true;
+    }
+    return false;
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    std::string names = "beginner,intermediate,expert,huge";
+    for (int i = 1; i < argc; i += 2) {
+        if (std::strcmp(argv[i], "--guess") == 0) {
+            options.guess = true;
+            --i; // Takes no value
+        } else if (i + 1 == argc) {
+            break;
+        } else if (std::strcmp(argv[i], "--suites") == 0) {
+            names = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--games") == 0) {
+            options.games = std::atoi(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            options.seed = std::strtoull(argv[i + 1], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            options.json_path = argv[i + 1];
+        }
+    }
+    for (char* token = std::strtok(&names[0], ","); token; token = std::strtok(nullptr, ",")) {
+        Suite suite;
+        if (findSuite(token, suite)) {
+            if (options.games > 0) suite.games = options.games;
+            options.suites.push_back(suite);
+        } else {
+            std::fprintf(stderr, "Unknown suite '%s'\n", token);
+        }
+    }
+    return options;
+}
+
+Result play(const Suite& suite, uint64_t seed, bool guess) {
+    Result result;
+    result.suite = suite;
+    MSBoard board(suite.rows, suite.cols, suite.mines, seed);
+    AdaptiveScheduler& scheduler = MinesweeperSolver::scheduler();
+    scheduler.reset();
+
+    auto start = Clock::now();
+    for (int game = 0; game < suite.games; ++game) {
+        board.reset(seed + game);
+        board.open(suite.rows / 2, suite.cols / 2);
+        if (guess) {
+            MinesweeperSolver::Budget budget;
+            budget.guess = true;
+            auto before = Clock::now();
+            MinesweeperSolver::RunResult run = MinesweeperSolver::solveUntilStuck(board, budget);
+            result.call_seconds.push_back(std::chrono::duration<double>(Clock::now() - before).count());
+            result.steps += run.steps;
+            result.lost += board.isLost();
+            result.won += board.isSolved();
+            continue;
+        }
+        while (true) {
+            auto before = Clock::now();
+            bool progress = MinesweeperSolver::solve(board);
+            result.call_seconds.push_back(std::chrono::duration<double>(Clock::now() - before).count());
+            if (!progress) break;
+            ++result.steps;
+        }
+        result.won += board.isSolved();
+    }
+    result.wall_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (int t = 0; t < AdaptiveScheduler::TIER_COUNT; ++t) {
+        result.tiers[t] = scheduler.counters(static_cast<AdaptiveScheduler::Tier>(t));
+    }
+    return result;
+}
+
+double percentile(std::vector<double>& values, double fraction) {
+    if (values.empty()) return 0;
+    size_t k = static_cast<size_t>(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+struct Summary {
+    double win_rate, steps_per_game, p50_us, p99_us, games_per_second;
+};
+
+Summary summarize(Result& result) {
+    const int games = result.suite.games;
+    Summary summary;
+    summary.win_rate = games ? static_cast<double>(result.won) / games : 0;
+    summary.steps_per_game = games ? static_cast<double>(result.steps) / games : 0;
+    summary.p50_us = percentile(result.call_seconds, 0.50) * 1e6;
+    summary.p99_us = percentile(result.call_seconds, 0.99) * 1e6;
+    summary.games_per_second = result.wall_seconds > 0 ? games / result.wall_seconds : 0;
+    return summary;
+}
+
+void printTiers(const Result& result) {
+    for (int t = 0; t < AdaptiveScheduler::TIER_COUNT; ++t) {
+        const AdaptiveScheduler::Counters& tier = result.tiers[t];
+        std::printf("  %-12s runs %8ld  productive %8ld  cells %9ld  skipped %7ld  %9.3f s\n",
+                    AdaptiveScheduler::name(static_cast<AdaptiveScheduler::Tier>(t)),
+                    tier.runs, tier.productive, tier.cells, tier.skipped, tier.seconds);
+    }
+}
+
+void writeJson(std::FILE* out, const Options& options, std::vector<Result>& results) {
+    std::fprintf(out, "{\n  \"seed\": %llu,\n  \"guess\": %s,\n  \"suites\": [",
+                 static_cast<unsigned long long>(options.seed), options.guess ? "true" : "false");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Suite& suite = results[i].suite;
+        Summary summary = summarize(results[i]);
+        std::fprintf(out,
+                     "%s\n    {\"name\": \"%s\", \"rows\": %d, \"cols\": %d, \"mines\": %d, \"games\": %d, "
+                     "\"won\": %d, \"lost\": %d, \"win_rate\": %.4f, \"steps_per_game\": %.2f, "
+                     "\"solve_p50_us\": %.2f, \"solve_p99_us\": %.2f, \"games_per_second\": %.1f, "
+                     "\"tiers\": {",
+                     i ? "," : "", suite.name.c_str(), suite.rows, suite.cols, suite.mines, suite.games,
+                     results[i].won, results[i].lost, summary.win_rate, summary.steps_per_game,
+                     summary.p50_us, summary.p99_us, summary.games_per_second);
+        for (int t = 0; t < AdaptiveScheduler::TIER_COUNT; ++t) {
+            const AdaptiveScheduler::Counters& tier = results[i].tiers[t];
+            std::fprintf(out,
+                         "%s\"%s\": {\"runs\": %ld, \"productive\": %ld, \"cells\": %ld, "
+                         "\"skipped\": %ld, \"seconds\": %.6f}",
+                         t ? ", " : "", AdaptiveScheduler::name(static_cast<AdaptiveScheduler::Tier>(t)),
+                         tier.runs, tier.productive, tier.cells, tier.skipped, tier.seconds);
+        }
+        std::fprintf(out, "}}");
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+    std::vector<Result> results;
+
+    std::printf("%-14s %15s %7s %9s %10s %10s %10s %10s\n", "suite", "size", "games", "win rate",
+                "steps/game", "p50(us)", "p99(us)", "games/s");
+    for (const Suite& suite : options.suites) {
+        results.push_back(play(suite, options.seed, options.guess));
+        Summary summary = summarize(results.back());
+        std::string size = std::to_string(suite.rows) + "x" + std::to_string(suite.cols) + "/" +
+                           std::to_string(suite.mines);
+        std::printf("%-14s %15s %7d %8.1f%% %10.2f %10.2f %10.2f %10.1f\n", suite.name.c_str(), size.c_str(),
+                    suite.games, summary.win_rate * 100, summary.steps_per_game,
+                    summary.p50_us, summary.p99_us, summary.games_per_second);
+        printTiers(results.back());
+        std::fflush(stdout);
+    }
+
+    if (!options.json_path.empty()) {
+        std::FILE* out = options.json_path == "-" ? stdout : std::fopen(options.json_path.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "Cannot write %s\n", options.json_path.c_str());
+            return 1;
+        }
+        writeJson(out, options, results);
+        if (out != stdout) std::fclose(out);
+    }
+    return 0;
+}
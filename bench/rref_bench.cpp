@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <armadillo>
+#include "../include/arma_helper.hpp"
+#include "../include/integer_rref.hpp"
+#include "../include/row_kernels.hpp"
+#include "bench_timer.hpp"
+#include "frontier_generator.hpp"
+
+/**
+ * Benchmark of the elimination engines on single-component frontier systems.
+ *
+ * Compares the legacy Armadillo compute_rref (including its conversions) with
+ * IntegerRREF using each row kernel the CPU supports.
+ *
+ * Usage: rref_bench [--sizes 100,200,...] [--arma-max N] [--min-time SECONDS]
+ */
+
+namespace {
+
+struct Options {
+    std::vector<int> sizes = {100, 200, 500, 1000, 2000, 5000};
+    int arma_max = 2000;      // The legacy engine is skipped above this many unknowns
+    double min_time = 0.2;    // Each measurement repeats until this much time has passed
+};
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--sizes") == 0) {
+            options.sizes.clear();
+            for (char* token = std::strtok(argv[i + 1], ","); token; token = std::strtok(nullptr, ",")) {
+                options.sizes.push_back(std::atoi(token));
+            }
+        } else if (std::strcmp(argv[i], "--arma-max") == 0) {
+            options.arma_max = std::atoi(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--min-time") == 0) {
+            options.min_time = std::atof(argv[i + 1]);
+        }
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+
+    std::vector<RowKernels::Isa> kernels;
+    for (auto isa : {RowKernels::Isa::Scalar, RowKernels::Isa::AVX2, RowKernels::Isa::AVX512}) {
+        if (RowKernels::select(isa)) kernels.push_back(isa);
+    }
+
+    std::printf("%8s %8s %14s", "unknowns", "rows", "armadillo(ms)");
+    for (auto isa : kernels) {
+        std::printf(" %12s", (std::string(RowKernels::name(isa)) + "(ms)").c_str());
+    }
+    std::printf(" %9s\n", "speedup");
+
+    for (int size : options.sizes) {
+        EquationSystem system = FrontierGenerator::strip(size, 0.2, 12345u + size);
+        std::printf("%8d %8d", system.variableCount(), system.equationCount());
+
+        double arma_seconds = 0;
+        if (size <= options.arma_max) {
+            arma_seconds = BenchTimer::timeIt([&] {
+                arma::mat reduced = compute_rref(convert_to_arma_mat(system));
+                convert_to_equation_system(reduced);
+            }, options.min_time);
+            std::printf(" %14.3f", arma_seconds * 1e3);
+        } else {
+            std::printf(" %14s", "skipped");
+        }
+
+        double best_seconds = 0;
+        for (auto isa : kernels) {
+            RowKernels::select(isa);
+            double seconds = BenchTimer::timeIt([&] { IntegerRREF::compute(system); }, options.min_time);
+            best_seconds = best_seconds == 0 ? seconds : std::min(best_seconds, seconds);
+            std::printf(" %12.3f", seconds * 1e3);
+        }
+
+        if (arma_seconds > 0) {
+            std::printf(" %8.1fx\n", arma_seconds / best_seconds);
+        } else {
+            std::printf(" %9s\n", "-");
+        }
+        std::fflush(stdout);
+    }
+    RowKernels::select(RowKernels::detect());
+    return 0;
+}
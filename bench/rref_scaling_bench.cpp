@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "../include/integer_rref.hpp"
+#include "bench_timer.hpp"
+#include "frontier_generator.hpp"
+
+/**
+ * Thread scaling of the parallel elimination in IntegerRREF on single-component
+ * frontier systems. Every size must be above PARALLEL_ELIMINATION_MIN_ENTRIES,
+ * otherwise the serial loop runs regardless of the thread count.
+ *
+ * Usage: rref_scaling_bench [--sizes 1000,2000,...] [--threads 1,2,4,...] [--min-time SECONDS]
+ */
+
+namespace {
+
+struct Options {
+    std::vector<int> sizes = {1000, 2000, 5000};
+    std::vector<unsigned> threads = {1, 2, 4, 8, 16};
+    double min_time = 0.5;    // Each measurement repeats until this much time has passed
+};
+
+std::vector<int> parseList(char* text) {
+    std::vector<int> values;
+    for (char* token = std::strtok(text, ","); token; token = std::strtok(nullptr, ",")) {
+        values.push_back(std::atoi(token));
+    }
+    return values;
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--sizes") == 0) {
+            options.sizes = parseList(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            options.threads.clear();
+            for (int count : parseList(argv[i + 1])) {
+                options.threads.push_back(static_cast<unsigned>(count));
+            }
+        } else if (std::strcmp(argv[i], "--min-time") == 0) {
+            options.min_time = std::atof(argv[i + 1]);
+        }
+    }
+    return options;
+}
+
+/**
+ * Compare two reduced systems entry by entry.
+ * @return True if they hold the same equations in the same order
+ */
+bool sameSystem(const EquationSystem& a, const EquationSystem& b) {
+    if (a.equationCount() != b.equationCount() || a.nonZeroCount() != b.nonZeroCount()) return false;
+    for (int i = 0; i < a.equationCount(); ++i) {
+        EquationSystem::Row x = a.equation(i);
+        EquationSystem::Row y = b.equation(i);
+        if (x.size != y.size || x.rhs != y.rhs) return false;
+        for (int k = 0; k < x.size; ++k) {
+            if (x.columns[k] != y.columns[k] || x.coefficients[k] != y.coefficients[k]) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("%8s %8s %8s %12s %9s %9s\n", "unknowns", "rows", "threads", "time(ms)", "speedup", "result");
+
+    for (int size : options.sizes) {
+        EquationSystem system = FrontierGenerator::strip(size, 0.2, 12345u + size);
+        const size_t entries = static_cast<size_t>(system.equationCount()) * (system.variableCount() + 1);
+        if (entries < IntegerRREF::PARALLEL_ELIMINATION_MIN_ENTRIES) {
+            std::printf("%8d %8d  below the parallel threshold, skipped\n",
+                        system.variableCount(), system.equationCount());
+            continue;
+        }
+
+        EquationSystem reference = IntegerRREF::compute(system, 1);
+        double serial_seconds = 0;
+        for (unsigned threads : options.threads) {
+            // One workspace per thread count, so the timings leave out starting the team
+            IntegerRREF::Workspace workspace;
+            EquationSystem reduced;
+            double seconds = BenchTimer::timeIt(
+                [&] { IntegerRREF::compute(system, reduced, workspace, threads); }, options.min_time);
+            if (serial_seconds == 0) serial_seconds = seconds;
+            std::printf("%8d %8d %8u %12.3f %8.2fx %9s\n", system.variableCount(), system.equationCount(),
+                        threads, seconds * 1e3, serial_seconds / seconds,
+                        sameSystem(reduced, reference) ? "ok" : "MISMATCH");
+            std::fflush(stdout);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "adaptive_scheduler.hpp"
+#include "solver_constants.hpp"
+
+void AdaptiveScheduler::Counters::add(int decided, double elapsed) {
+    ++runs;
+    productive += decided > 0;
+    cells += decided;
+    seconds += elapsed;
+}
+
+void AdaptiveScheduler::record(Tier tier, int cells, double seconds, double cost) {
+    totals[static_cast<int>(tier)].add(cells, seconds);
+
+    if (tier != Tier::Elimination) return;
+    const double weight = SolverConstants::SCHEDULER_SMOOTHING;
+    hit_rate += weight * ((cells > 0 ? 1.0 : 0.0) - hit_rate);
+    if (cost > 0) {
+        double measured = seconds / cost;
+        seconds_per_cost = seconds_per_cost == 0 ? measured : seconds_per_cost + weight * (measured - seconds_per_cost);
+    }
+}
+
+void AdaptiveScheduler::recordSkip(Tier tier) {
+    ++totals[static_cast<int>(tier)].skipped;
+}
+
+bool AdaptiveScheduler::shouldEliminate(bool stalled, double cost, double cheapSeconds) const {
+    if (stalled) return true;                // Nothing else can make progress
+    if (seconds_per_cost == 0) return true;  // No timing yet: measure once
+    return hit_rate * cheapSeconds >= seconds_per_cost * cost;
+}
+
+const AdaptiveScheduler::Counters& AdaptiveScheduler::counters(Tier tier) const {
+    return totals[static_cast<int>(tier)];
+}
+
+const char* AdaptiveScheduler::name(Tier tier) {
+    switch (tier) {
+        case Tier::Rules: return "rules";
+        case Tier::Equations: return "equations";
+        case Tier::Presolve: return "presolve";
+        case Tier::Elimination: return "elimination";
+        case Tier::Probability: return "probability";
+    }
+    return "unknown";
+}
+
+void AdaptiveScheduler::reset() {
+    totals = {};
+    hit_rate = 1.0;
+    seconds_per_cost = 0;
+}
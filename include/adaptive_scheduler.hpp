@@ -0,0 +1,102 @@
+#ifndef ADAPTIVE_SCHEDULER_HPP
+#define ADAPTIVE_SCHEDULER_HPP
+
+#include <array>
+
+/**
+ * Decides when a solve step escalates from the cheap tiers to elimination,
+ * and counts where the solver's time goes.
+ *
+ * The cheap tiers (single-cell rules, building the equations, presolve) run
+ * on every step. Elimination always runs once they stall, since nothing
+ * else can make progress. While they are still making progress, elimination
+ * runs only if its expected yield pays for it: the learned hit rate of
+ * recent eliminations times the cost of the extra step it could save (the
+ * cheap tiers' time this step) must reach its predicted time (the learned
+ * seconds per unit of matrix cost times this step's cost). Both estimates
+ * are exponential moving averages, so the policy follows the game as the
+ * frontier grows and shrinks.
+ */
+class AdaptiveScheduler {
+public:
+    /**
+     * Stages of a solve step, cheapest first.
+     */
+    enum class Tier {
+        Rules,        // BitboardRules to a fixpoint
+        Equations,    // Frontier equation building
+        Presolve,     // Presolve of the frontier equations
+        Elimination,  // Per-component row reduction
+        Probability   // Exact mine probabilities and guessing (solveUntilStuck only)
+    };
+
+    static constexpr int TIER_COUNT = 5;
+
+    /**
+     * Totals for one tier.
+     */
+    struct Counters {
+        long runs = 0;         // Times the tier ran
+        long productive = 0;   // Runs that decided at least one cell
+        long cells = 0;        // Cells decided
+        long skipped = 0;      // Times the scheduler chose not to run it
+        double seconds = 0;    // Time spent in the tier
+
+        /**
+         * Count one run of the tier.
+         * @param decided Cells the run decided
+         * @param elapsed Time the run took
+         */
+        void add(int decided, double elapsed);
+    };
+
+    /**
+     * Record one run of a tier.
+     * @param tier The tier that ran
+     * @param cells Cells it decided
+     * @param seconds Time it took
+     * @param cost For elimination, the matrix cost it was scheduled with (see shouldEliminate)
+     */
+    void record(Tier tier, int cells, double seconds, double cost = 0);
+
+    /**
+     * Record that the scheduler skipped a tier.
+     * @param tier The skipped tier
+     */
+    void recordSkip(Tier tier);
+
+    /**
+     * Decide whether this step should run elimination.
+     * @param stalled True if the cheap tiers decided nothing this step
+     * @param cost Estimated elimination work, rows * cols * min(rows, cols) summed over components
+     * @param cheapSeconds Time the cheap tiers took this step
+     * @return True to run elimination now
+     */
+    bool shouldEliminate(bool stalled, double cost, double cheapSeconds) const;
+
+    /**
+     * Get a tier's totals.
+     * @param tier The tier
+     * @return Its counters since the last reset
+     */
+    const Counters& counters(Tier tier) const;
+
+    /**
+     * Get a tier's display name.
+     * @param tier The tier
+     * @return Lower-case name
+     */
+    static const char* name(Tier tier);
+
+    /**
+     * Clear the counters and the learned estimates.
+     */
+    void reset();
+
+private:
+    std::array<Counters, TIER_COUNT> totals{};
+    double hit_rate = 1.0;         // Moving average of productive eliminations; starts optimistic
+    double seconds_per_cost = 0;   // Moving average of elimination time per cost unit, 0 until measured
+};
+
+#endif // ADAPTIVE_SCHEDULER_HPP
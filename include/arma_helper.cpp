@@ -1,6 +1,5 @@
 #include <iostream>
 #include <vector>
-#define ARMA_DONT_USE_STD_MUTEX
 #include <armadillo>
 #include "arma_helper.hpp"
 
@@ -30,6 +29,38 @@ arma::mat convert_to_arma_mat(const std::vector<std::vector<int>>& vec) {
     return mat;
 }
 
+// Function to convert a sparse EquationSystem to an augmented arma::mat
+arma::mat convert_to_arma_mat(const EquationSystem& system) {
+    size_t rows = system.equationCount();
+    size_t cols = system.variableCount() + 1;
+    arma::mat mat(rows, cols, arma::fill::zeros);
+
+    for (size_t i = 0; i < rows; ++i) {
+        EquationSystem::Row equation = system.equation(i);
+        for (int k = 0; k < equation.size; ++k) {
+            mat(i, equation.columns[k]) = equation.coefficients[k];
+        }
+        mat(i, cols - 1) = equation.rhs;
+    }
+
+    return mat;
+}
+
+// Function to convert an augmented arma::mat to a sparse EquationSystem
+EquationSystem convert_to_equation_system(const arma::mat& mat) {
+    EquationSystem system(mat.n_cols - 1);
+    for (size_t i = 0; i < mat.n_rows; ++i) {
+        for (size_t j = 0; j + 1 < mat.n_cols; ++j) {
+            int value = static_cast<int>(mat(i, j));
+            if (value != 0) {
+                system.addTerm(j, value);
+            }
+        }
+        system.finishEquation(static_cast<int>(mat(i, mat.n_cols - 1)));
+    }
+    return system;
+}
+
 // Function to compute RREF
 arma::mat compute_rref(const arma::mat& A) {
     arma::mat R = A;
@@ -55,7 +86,7 @@ arma::mat compute_rref(const arma::mat& A) {
         R.swap_rows(i, r);
         R.row(r) = R.row(r) / R(r, lead);
         for (size_t j = 0; j < rowCount; ++j) {
-            if (j != r) {
+            if (j != r && R(j, lead) != 0) { // Skip rows with nothing to eliminate
                 R.row(j) -= R.row(r) * R(j, lead);
             }
         }
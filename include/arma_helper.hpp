@@ -1,6 +1,9 @@
 #include <vector>
 #include <armadillo>
+#include "equation_system.hpp"
 
 std::vector<std::vector<int>> convert_to_vector(const arma::mat& mat);
 arma::mat convert_to_arma_mat(const std::vector<std::vector<int>>& vec);
+arma::mat convert_to_arma_mat(const EquationSystem& system);
+EquationSystem convert_to_equation_system(const arma::mat& mat);
 arma::mat compute_rref(const arma::mat& A);
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "big_int.hpp"
+#include <stdexcept>
+#include <utility>
+
+BigInt::BigInt(int64_t value) {
+    negative = value < 0;
+    // Negate in unsigned arithmetic so INT64_MIN is handled correctly
+    uint64_t magnitude = negative ? ~static_cast<uint64_t>(value) + 1 : static_cast<uint64_t>(value);
+    while (magnitude != 0) {
+        limbs.push_back(static_cast<uint32_t>(magnitude));
+        magnitude >>= 32;
+    }
+}
+
+bool BigInt::isZero() const {
+    return limbs.empty();
+}
+
+int BigInt::sign() const {
+    if (limbs.empty()) return 0;
+    return negative ? -1 : 1;
+}
+
+bool BigInt::fitsIn(int64_t min_value, int64_t max_value) const {
+    if (limbs.size() > 2) return false;
+    uint64_t magnitude = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+        magnitude = (magnitude << 32) | limbs[i];
+    }
+    if (negative) {
+        uint64_t limit = ~static_cast<uint64_t>(min_value) + 1;
+        return min_value < 0 && magnitude <= limit;
+    }
+    return max_value >= 0 && magnitude <= static_cast<uint64_t>(max_value);
+}
+
+int64_t BigInt::toInt64() const {
+    uint64_t magnitude = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+        magnitude = (magnitude << 32) | limbs[i];
+    }
+    return negative ? static_cast<int64_t>(~magnitude + 1) : static_cast<int64_t>(magnitude);
+}
+
+BigInt BigInt::operator-() const {
+    BigInt result = *this;
+    if (!result.limbs.empty()) result.negative = !result.negative;
+    return result;
+}
+
+BigInt BigInt::operator+(const BigInt& other) const {
+    BigInt result;
+    if (negative == other.negative) {
+        result.limbs = addMagnitude(limbs, other.limbs);
+        result.negative = negative;
+    } else if (compareMagnitude(limbs, other.limbs) >= 0) {
+        result.limbs = subMagnitude(limbs, other.limbs);
+        result.negative = negative;
+    } else {
+        result.limbs = subMagnitude(other.limbs, limbs);
+        result.negative = other.negative;
+    }
+    result.trim();
+    return result;
+}
+
+BigInt BigInt::operator-(const BigInt& other) const {
+    return *this + (-other);
+}
+
+BigInt BigInt::operator*(const BigInt& other) const {
+    BigInt result;
+    if (isZero() || other.isZero()) return result;
+
+    result.limbs.assign(limbs.size() + other.limbs.size(), 0);
+    for (size_t i = 0; i < limbs.size(); ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < other.limbs.size(); ++j) {
+            uint64_t current = static_cast<uint64_t>(limbs[i]) * other.limbs[j] +
+                               result.limbs[i + j] + carry;
+            result.limbs[i + j] = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        result.limbs[i + other.limbs.size()] = static_cast<uint32_t>(carry);
+    }
+    result.negative = negative != other.negative;
+    result.trim();
+    return result;
+}
+
+BigInt BigInt::operator/(const BigInt& divisor) const {
+    if (divisor.isZero()) {
+        throw std::domain_error("BigInt division by zero");
+    }
+    BigInt quotient, remainder;
+    divModMagnitude(limbs, divisor.limbs, quotient.limbs, remainder.limbs);
+    quotient.negative = negative != divisor.negative;
+    quotient.trim();
+    return quotient;
+}
+
+BigInt BigInt::operator%(const BigInt& divisor) const {
+    if (divisor.isZero()) {
+        throw std::domain_error("BigInt division by zero");
+    }
+    BigInt quotient, remainder;
+    divModMagnitude(limbs, divisor.limbs, quotient.limbs, remainder.limbs);
+    remainder.negative = negative;
+    remainder.trim();
+    return remainder;
+}
+
+bool BigInt::operator==(const BigInt& other) const {
+    return negative == other.negative && limbs == other.limbs;
+}
+
+bool BigInt::operator!=(const BigInt& other) const {
+    return !(*this == other);
+}
+
+BigInt BigInt::gcd(BigInt a, BigInt b) {
+    a.negative = false;
+    b.negative = false;
+    while (!b.isZero()) {
+        BigInt remainder = a % b;
+        a = std::move(b);
+        b = std::move(remainder);
+    }
+    return a;
+}
+
+void BigInt::trim() {
+    while (!limbs.empty() && limbs.back() == 0) {
+        limbs.pop_back();
+    }
+    if (limbs.empty()) negative = false;
+}
+
+int BigInt::compareMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+std::vector<uint32_t> BigInt::addMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    const std::vector<uint32_t>& longer = a.size() >= b.size() ? a : b;
+    const std::vector<uint32_t>& shorter = a.size() >= b.size() ? b : a;
+
+    std::vector<uint32_t> result(longer.size() + 1, 0);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < longer.size(); ++i) {
+        uint64_t current = static_cast<uint64_t>(longer[i]) + carry;
+        if (i < shorter.size()) current += shorter[i];
+        result[i] = static_cast<uint32_t>(current);
+        carry = current >> 32;
+    }
+    result[longer.size()] = static_cast<uint32_t>(carry);
+    return result;
+}
+
+std::vector<uint32_t> BigInt::subMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    // Requires |a| >= |b|
+    std::vector<uint32_t> result(a.size(), 0);
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        int64_t current = static_cast<int64_t>(a[i]) - borrow;
+        if (i < b.size()) current -= b[i];
+        borrow = current < 0 ? 1 : 0;
+        if (current < 0) current += (int64_t(1) << 32);
+        result[i] = static_cast<uint32_t>(current);
+    }
+    return result;
+}
+
+void BigInt::divModMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b,
+                             std::vector<uint32_t>& quotient, std::vector<uint32_t>& remainder) {
+    quotient.assign(a.size(), 0);
+    remainder.clear();
+
+    // Single limb divisor: schoolbook division by a machine word
+    if (b.size() == 1) {
+        uint64_t rem = 0;
+        for (size_t i = a.size(); i-- > 0;) {
+            uint64_t current = (rem << 32) | a[i];
+            quotient[i] = static_cast<uint32_t>(current / b[0]);
+            rem = current % b[0];
+        }
+        if (rem != 0) remainder.push_back(static_cast<uint32_t>(rem));
+        return;
+    }
+
+    // General case: binary long division. This path only runs when the 64-bit
+    // engine overflowed, so simplicity is preferred over speed.
+    for (size_t bit = a.size() * 32; bit-- > 0;) {
+        // remainder = remainder * 2 + next bit of a
+        uint32_t carry = (a[bit / 32] >> (bit % 32)) & 1u;
+        for (auto& limb : remainder) {
+            uint32_t next_carry = limb >> 31;
+            limb = (limb << 1) | carry;
+            carry = next_carry;
+        }
+        if (carry) remainder.push_back(carry);
+
+        if (compareMagnitude(remainder, b) >= 0) {
+            remainder = subMagnitude(remainder, b);
+            while (!remainder.empty() && remainder.back() == 0) remainder.pop_back();
+            quotient[bit / 32] |= (1u << (bit % 32));
+        }
+    }
+}
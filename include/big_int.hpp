@@ -0,0 +1,90 @@
+#ifndef BIG_INT_HPP
+#define BIG_INT_HPP
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Minimal arbitrary precision signed integer.
+ * Only the operations needed by exact row reduction are provided; it is used as
+ * the fallback number type when 64-bit elimination would overflow.
+ */
+class BigInt {
+private:
+    bool negative = false;
+    std::vector<uint32_t> limbs; // Magnitude, least significant limb first, no leading zeros
+
+public:
+    BigInt() = default;
+
+    /**
+     * Construct from a 64-bit signed integer.
+     * @param value The initial value
+     */
+    BigInt(int64_t value);
+
+    /**
+     * Check whether the value is zero.
+     * @return True if the value is zero, false otherwise
+     */
+    bool isZero() const;
+
+    /**
+     * Get the sign of the value.
+     * @return -1, 0 or 1
+     */
+    int sign() const;
+
+    /**
+     * Check whether the value fits in the given signed range.
+     * @param min_value Smallest accepted value
+     * @param max_value Largest accepted value
+     * @return True if min_value <= this <= max_value
+     */
+    bool fitsIn(int64_t min_value, int64_t max_value) const;
+
+    /**
+     * Convert to a 64-bit signed integer.
+     * Only valid when fitsIn(INT64_MIN, INT64_MAX) holds.
+     * @return The value as int64_t
+     */
+    int64_t toInt64() const;
+
+    BigInt operator-() const;
+    BigInt operator+(const BigInt& other) const;
+    BigInt operator-(const BigInt& other) const;
+    BigInt operator*(const BigInt& other) const;
+
+    /**
+     * Truncating division, matching the semantics of built-in integer division.
+     * @throws std::domain_error if divisor is zero
+     */
+    BigInt operator/(const BigInt& divisor) const;
+
+    /**
+     * Remainder of truncating division; takes the sign of the dividend.
+     * @throws std::domain_error if divisor is zero
+     */
+    BigInt operator%(const BigInt& divisor) const;
+
+    bool operator==(const BigInt& other) const;
+    bool operator!=(const BigInt& other) const;
+
+    /**
+     * Greatest common divisor of the absolute values.
+     * @param a First value
+     * @param b Second value
+     * @return gcd(|a|, |b|), zero only if both are zero
+     */
+    static BigInt gcd(BigInt a, BigInt b);
+
+private:
+    void trim();
+    static int compareMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+    static std::vector<uint32_t> addMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+    static std::vector<uint32_t> subMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+    static void divModMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b,
+                                std::vector<uint32_t>& quotient, std::vector<uint32_t>& remainder);
+};
+
+#endif // BIG_INT_HPP
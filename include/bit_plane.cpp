@@ -0,0 +1,31 @@
+#include "bit_plane.hpp"
+
+void BitPlane::reset(size_t bitCount) {
+    words.assign((bitCount + 63) / 64, 0);
+}
+
+bool BitPlane::any() const {
+    for (uint64_t word : words) {
+        if (word != 0) return true;
+    }
+    return false;
+}
+
+size_t BitPlane::count() const {
+    size_t total = 0;
+    for (uint64_t word : words) {
+        total += __builtin_popcountll(word);
+    }
+    return total;
+}
+
+void BitPlane::dilate(const BitPlane& source, const std::array<int, 8>& offsets) {
+    words.resize(source.words.size());
+    for (size_t w = 0; w < words.size(); ++w) {
+        uint64_t bits = 0;
+        for (int offset : offsets) {
+            bits |= source.shifted(w, offset);
+        }
+        words[w] = bits;
+    }
+}
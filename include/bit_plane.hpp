@@ -0,0 +1,175 @@
+#ifndef BIT_PLANE_HPP
+#define BIT_PLANE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "board_grid.hpp"
+
+/**
+ * One bit per BoardGrid cell index, packed into 64-bit words.
+ *
+ * Because BoardGrid pads every row with border cells, shifting a whole plane
+ * by one of BoardGrid::neighborOffsets() moves every cell onto its neighbour
+ * without bits wrapping between rows. shifted() gives one word of such a
+ * shift, so neighbourhood operations run 64 cells at a time.
+ */
+class BitPlane {
+public:
+    /**
+     * Bit-sliced 4-bit counter: lane i holds a count (0-15) for bit i of a word.
+     */
+    struct Counter {
+        uint64_t bit0 = 0, bit1 = 0, bit2 = 0, bit3 = 0;
+
+        /**
+         * Add 1 to every lane whose bit is set in x.
+         * @param x Lanes to increment
+         */
+        void add(uint64_t x) {
+            uint64_t carry0 = bit0 & x;
+            bit0 ^= x;
+            uint64_t carry1 = bit1 & carry0;
+            bit1 ^= carry0;
+            uint64_t carry2 = bit2 & carry1;
+            bit2 ^= carry1;
+            bit3 ^= carry2;
+        }
+
+        /**
+         * @param value Count to compare with, 0-15
+         * @return Mask of the lanes holding value
+         */
+        uint64_t equals(int value) const {
+            auto mask = [](int bit) { return bit ? ~uint64_t(0) : uint64_t(0); };
+            return ~((bit0 ^ mask(value & 1)) | (bit1 ^ mask(value & 2)) |
+                     (bit2 ^ mask(value & 4)) | (bit3 ^ mask(value & 8)));
+        }
+
+        /**
+         * @param lane Bit position, 0-63
+         * @return The count held by that lane
+         */
+        int value(int lane) const {
+            return static_cast<int>(((bit0 >> lane) & 1) | (((bit1 >> lane) & 1) << 1) |
+                                    (((bit2 >> lane) & 1) << 2) | (((bit3 >> lane) & 1) << 3));
+        }
+    };
+
+    /**
+     * Resize to bitCount bits, all clear, reusing storage.
+     * @param bitCount Number of cell indices (BoardGrid::size())
+     */
+    void reset(size_t bitCount);
+
+    void set(int index) { words[index >> 6] |= uint64_t(1) << (index & 63); }
+    void clear(int index) { words[index >> 6] &= ~(uint64_t(1) << (index & 63)); }
+    bool test(int index) const { return (words[index >> 6] >> (index & 63)) & 1; }
+
+    size_t wordCount() const { return words.size(); }
+    uint64_t word(size_t w) const { return words[w]; }
+    uint64_t& word(size_t w) { return words[w]; }
+
+    /**
+     * Get word w of this plane shifted so that bit i holds the bit of cell i + offset.
+     * Bits shifted in from outside the plane are clear.
+     * @param w Word index
+     * @param offset Cell index offset, typically a neighbour offset
+     * @return The shifted word
+     */
+    uint64_t shifted(size_t w, int offset) const {
+        const long bit = static_cast<long>(w) * 64 + offset;
+        const long q = bit >> 6;
+        const int r = static_cast<int>(bit & 63);
+        uint64_t low = at(q) >> r;
+        uint64_t high = r == 0 ? 0 : at(q + 1) << (64 - r);
+        return low | high;
+    }
+
+    /**
+     * Keep only the bits also set in other.
+     * @param other Plane of the same size
+     * @return This plane
+     */
+    BitPlane& operator&=(const BitPlane& other) {
+        for (size_t w = 0; w < words.size(); ++w) {
+            words[w] &= other.words[w];
+        }
+        return *this;
+    }
+
+    /**
+     * Count, for each cell of word w, how many of its neighbours are set.
+     * @param w Word index
+     * @param offsets Neighbour offsets of the grid the plane indexes
+     * @return One count per bit of the word
+     */
+    Counter countNeighbors(size_t w, const std::array<int, 8>& offsets) const {
+        Counter counter;
+        for (int offset : offsets) {
+            counter.add(shifted(w, offset));
+        }
+        return counter;
+    }
+
+    /**
+     * Set every cell that has a neighbour set in source, and clear the rest.
+     * @param source Plane to dilate; must not be this plane
+     * @param offsets Neighbour offsets of the grid the planes index
+     */
+    void dilate(const BitPlane& source, const std::array<int, 8>& offsets);
+
+    /**
+     * Set the bit of every cell of a grid whose value satisfies a predicate.
+     * Border cells are tested too, so the predicate should reject BoardGrid::BORDER.
+     * @param grid Grid to read; the plane is resized to grid.size() bits
+     * @param predicate Called as predicate(int8_t value)
+     */
+    template <typename Predicate>
+    void assign(const BoardGrid& grid, Predicate predicate) {
+        const size_t size = grid.size();
+        words.resize((size + 63) / 64);
+        for (size_t w = 0; w < words.size(); ++w) {
+            const size_t first = w * 64;
+            const size_t count = size - first < 64 ? size - first : 64;
+            uint64_t bits = 0;
+            for (size_t b = 0; b < count; ++b) {
+                bits |= uint64_t(predicate(grid[static_cast<int>(first + b)])) << b;
+            }
+            words[w] = bits;
+        }
+    }
+
+    /**
+     * @return True if any bit is set
+     */
+    bool any() const;
+
+    /**
+     * @return Number of set bits
+     */
+    size_t count() const;
+
+    /**
+     * Call a function with the index of every set bit, in ascending order.
+     * @param function Called as function(int index)
+     */
+    template <typename Function>
+    void forEach(Function function) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                function(static_cast<int>(w * 64 + __builtin_ctzll(bits)));
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> words;
+
+    uint64_t at(long w) const {
+        return w < 0 || w >= static_cast<long>(words.size()) ? 0 : words[w];
+    }
+};
+
+#endif // BIT_PLANE_HPP
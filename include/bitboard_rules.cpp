@@ -0,0 +1,119 @@
+#include "bitboard_rules.hpp"
+#include "solver_constants.hpp"
+#include "../src/minesweeper_class.hpp"
+
+BitboardRules::Stats BitboardRules::run(MSBoard& board) {
+    load(board);
+    return fixpoint(board);
+}
+
+BitboardRules::Stats BitboardRules::resume(MSBoard& board) {
+    const std::vector<int>& changed = board.changedCells();
+    for (size_t i = log_cursor; i < changed.size(); ++i) {
+        sync(board, changed[i]);
+    }
+    log_cursor = changed.size();
+    return fixpoint(board);
+}
+
+BitboardRules::Stats BitboardRules::fixpoint(MSBoard& board) {
+    Stats stats;
+    const BoardGrid& state = board.revealedBoard;
+    const std::array<int, 8> offsets = SolverConstants::neighborOffsets(state.stride());
+
+    while (true) {
+        ++stats.rounds;
+        if (!findDeductions(offsets)) break;
+
+        mines.forEach([&](int index) {
+            board.markMine(state.row(index), state.col(index));
+            flags.set(index);
+            unrevealed.clear(index);
+            ++stats.mines;
+        });
+        const size_t logged = board.changedCells().size();
+        safe.forEach([&](int index) {
+            // An earlier open in this pass may already have cascaded over it
+            if (stats.lost || state[index] != SolverConstants::UNREVEALED) return;
+            if (board.open(state.row(index), state.col(index)) == MSBoard::OpenResult::Mine) {
+                // Only a wrong flag can lead here; the mine stays unrevealed and would be deduced again
+                stats.lost = true;
+                return;
+            }
+            ++stats.safe;
+        });
+
+        // Opening can cascade past the deduced cells, so read every cell it revealed
+        const std::vector<int>& changed = board.changedCells();
+        for (size_t i = logged; i < changed.size(); ++i) {
+            reveal(board, changed[i]);
+        }
+        if (stats.lost) break;
+    }
+    log_cursor = board.changedCells().size();
+    return stats;
+}
+
+void BitboardRules::load(const MSBoard& board) {
+    const BoardGrid& state = board.revealedBoard;
+    revealed.assign(state, [](int8_t value) { return value >= 0 && value <= MAX_NUMBER; });
+    flags.assign(state, [](int8_t value) { return value == SolverConstants::MARKED_MINE; });
+    unrevealed.assign(state, [](int8_t value) { return value == SolverConstants::UNREVEALED; });
+    for (int number = 0; number <= MAX_NUMBER; ++number) {
+        numbers[number].assign(state, [number](int8_t value) { return value == number; });
+    }
+}
+
+void BitboardRules::sync(const MSBoard& board, int index) {
+    if (board.revealedBoard[index] == SolverConstants::MARKED_MINE) {
+        flags.set(index);
+        unrevealed.clear(index);
+    } else {
+        reveal(board, index);
+    }
+}
+
+void BitboardRules::reveal(const MSBoard& board, int index) {
+    int value = board.revealedBoard[index];
+    if (value < 0 || value > MAX_NUMBER || revealed.test(index)) return;
+    unrevealed.clear(index);
+    revealed.set(index);
+    numbers[value].set(index);
+}
+
+bool BitboardRules::findDeductions(const std::array<int, 8>& offsets) {
+    const size_t words = revealed.wordCount();
+    covered.reset(words * 64);
+    safe_sources.reset(words * 64);
+    mine_sources.reset(words * 64);
+    for (size_t w = 0; w < words; ++w) {
+        covered.word(w) = flags.word(w) | unrevealed.word(w);
+    }
+
+    // Flagged and flagged-or-unrevealed neighbour counts for every revealed cell
+    for (size_t w = 0; w < words; ++w) {
+        if (revealed.word(w) == 0) continue;
+        BitPlane::Counter flagged = flags.countNeighbors(w, offsets);
+        BitPlane::Counter around = covered.countNeighbors(w, offsets);
+        uint64_t to_safe = 0, to_mine = 0;
+        for (int value = 0; value <= MAX_NUMBER; ++value) {
+            uint64_t cells = numbers[value].word(w);
+            if (cells == 0) continue;
+            to_safe |= cells & flagged.equals(value);
+            to_mine |= cells & around.equals(value);
+        }
+        safe_sources.word(w) = to_safe;
+        mine_sources.word(w) = to_mine;
+    }
+
+    // Spread each rule to the unrevealed neighbours of the cells it holds for
+    safe.dilate(safe_sources, offsets);
+    mines.dilate(mine_sources, offsets);
+    bool found = false;
+    for (size_t w = 0; w < words; ++w) {
+        mines.word(w) &= unrevealed.word(w);
+        safe.word(w) &= unrevealed.word(w) & ~mines.word(w);
+        found = found || mines.word(w) != 0 || safe.word(w) != 0;
+    }
+    return found;
+}
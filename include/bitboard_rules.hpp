@@ -0,0 +1,79 @@
+#ifndef BITBOARD_RULES_HPP
+#define BITBOARD_RULES_HPP
+
+#include <array>
+#include <cstdint>
+#include "bit_plane.hpp"
+
+// Forward declarations
+class MSBoard;
+
+/**
+ * Single-cell deductions over the whole board, 64 cells at a time.
+ *
+ * The board is held as bitplanes over BoardGrid cell indices: revealed
+ * cells, flags, unrevealed cells and one plane per number 0-8. Neighbour
+ * counts come from adding the eight shifted flag (or flag-or-unrevealed)
+ * planes into bit-sliced 4-bit counters, so one pass applies both rules
+ * to every revealed cell:
+ *  - number == flagged neighbours: every unrevealed neighbour is safe
+ *  - number == flagged + unrevealed neighbours: every unrevealed neighbour is a mine
+ * Deductions are applied to the board, the planes are updated with the
+ * newly revealed numbers, and this repeats until nothing changes.
+ *
+ * Buffers are kept between calls, so an object should be reused; resume()
+ * also keeps the planes, so a caller that alternates the rules with other
+ * deductions does not reload the board every time.
+ */
+class BitboardRules {
+public:
+    /**
+     * What one run did.
+     */
+    struct Stats {
+        int rounds = 0;     // Whole-board passes, including the last one that found nothing
+        int mines = 0;      // Cells marked as mines
+        int safe = 0;       // Cells opened
+        bool lost = false;  // A cell deduced safe was a mine; the run stopped there
+    };
+
+    /**
+     * Apply the single-cell rules to the board until they find nothing new,
+     * or until a cell they open turns out to be a mine.
+     * @param board Reference to the Minesweeper board; cells are opened and marked
+     * @return Counts of the work done
+     */
+    Stats run(MSBoard& board);
+
+    /**
+     * Same as run(), but continue from the planes the previous run() or resume()
+     * left instead of reloading the whole board: only the cells logged in
+     * MSBoard::changedCells() since then are read. The board must be the same one,
+     * not reset since, and changed only through open() and markMine().
+     * @param board Reference to the Minesweeper board; cells are opened and marked
+     * @return Counts of the work done
+     */
+    Stats resume(MSBoard& board);
+
+private:
+    static constexpr int MAX_NUMBER = 8;
+
+    BitPlane revealed;
+    BitPlane flags;
+    BitPlane unrevealed;
+    std::array<BitPlane, MAX_NUMBER + 1> numbers;
+    BitPlane covered;       // Flagged or unrevealed
+    BitPlane safe_sources;  // Numbers satisfied by their flags
+    BitPlane mine_sources;  // Numbers that need every unrevealed neighbour
+    BitPlane safe;
+    BitPlane mines;
+    size_t log_cursor = 0;  // Change log entries the planes reflect
+
+    Stats fixpoint(MSBoard& board);
+    void load(const MSBoard& board);
+    void sync(const MSBoard& board, int index);
+    void reveal(const MSBoard& board, int index);
+    bool findDeductions(const std::array<int, 8>& offsets);
+};
+
+#endif // BITBOARD_RULES_HPP
@@ -0,0 +1,30 @@
+#include "board_grid.hpp"
+#include "solver_constants.hpp"
+#include <algorithm>
+
+BoardGrid::BoardGrid() {
+    reset(0, 0, 0);
+}
+
+BoardGrid::BoardGrid(int rows, int cols, int8_t value) {
+    reset(rows, cols, value);
+}
+
+void BoardGrid::reset(int rows, int cols, int8_t value) {
+    row_count = rows;
+    col_count = cols;
+    row_stride = cols + 2;
+    cells.assign(static_cast<size_t>(rows + 2) * row_stride, BORDER);
+    fill(value);
+    neighbor_offsets = SolverConstants::neighborOffsets(row_stride);
+}
+
+void BoardGrid::fill(int8_t value) {
+    for (int r = 0; r < row_count; ++r) {
+        std::fill_n(cells.begin() + index(r, 0), col_count, value);
+    }
+}
+
+bool BoardGrid::operator==(const BoardGrid& other) const {
+    return row_count == other.row_count && col_count == other.col_count && cells == other.cells;
+}
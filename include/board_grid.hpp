@@ -0,0 +1,86 @@
+#ifndef BOARD_GRID_HPP
+#define BOARD_GRID_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Contiguous board of int8 cells surrounded by a one-cell border.
+ *
+ * Cells are stored row-major with a stride of cols + 2. The border holds
+ * BORDER, so the eight neighbours of any cell on the board can be read at the
+ * fixed offsets in neighborOffsets() without bounds checks. A cell index is a
+ * position in this padded layout; index(), row() and col() convert between
+ * indices and (row, col) coordinates.
+ */
+class BoardGrid {
+public:
+    static constexpr int8_t BORDER = -3; // Value of every padding cell; never a board value
+
+    /**
+     * Create an empty 0 x 0 grid.
+     */
+    BoardGrid();
+
+    /**
+     * Create a grid with every cell set to value.
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param value Initial cell value
+     */
+    BoardGrid(int rows, int cols, int8_t value);
+
+    /**
+     * Resize the grid and set every cell to value, reusing storage.
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param value Initial cell value
+     */
+    void reset(int rows, int cols, int8_t value);
+
+    /**
+     * Set every cell on the board to value, leaving the border untouched.
+     * @param value The new cell value
+     */
+    void fill(int8_t value);
+
+    int rows() const { return row_count; }
+    int cols() const { return col_count; }
+    int stride() const { return row_stride; }
+    bool empty() const { return row_count == 0 || col_count == 0; }
+
+    /**
+     * Get the number of stored cells, border included. Every cell index is below this.
+     * @return The padded cell count
+     */
+    size_t size() const { return cells.size(); }
+
+    int index(int r, int c) const { return (r + 1) * row_stride + c + 1; }
+    int row(int index) const { return index / row_stride - 1; }
+    int col(int index) const { return index % row_stride - 1; }
+
+    /**
+     * Get the index offsets of the eight neighbours, in SolverConstants::NEIGHBOR_DIRECTIONS order.
+     * @return Offsets to add to a cell index
+     */
+    const std::array<int, 8>& neighborOffsets() const { return neighbor_offsets; }
+
+    int8_t operator()(int r, int c) const { return cells[index(r, c)]; }
+    int8_t& operator()(int r, int c) { return cells[index(r, c)]; }
+    int8_t operator[](int index) const { return cells[index]; }
+    int8_t& operator[](int index) { return cells[index]; }
+
+    bool operator==(const BoardGrid& other) const;
+    bool operator!=(const BoardGrid& other) const { return !(*this == other); }
+
+private:
+    int row_count = 0;
+    int col_count = 0;
+    int row_stride = 2;
+    std::vector<int8_t> cells;
+    std::array<int, 8> neighbor_offsets{};
+};
+
+#endif // BOARD_GRID_HPP
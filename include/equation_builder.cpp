@@ -1,89 +1,77 @@
 #include "equation_builder.hpp"
-#include <algorithm>
+#include <array>
 
-TwoWayDict EquationBuilder::identifyUnrevealedSquares(const std::vector<std::vector<int>>& state, 
-                                                     int rows, int cols) {
-    TwoWayDict unrevealed_indices;
-    int index_counter = 0;
+namespace {
 
-    for (int r = 0; r < rows; ++r) {
-        for (int c = 0; c < cols; ++c) {
-            if (state[r][c] >= 0) { // Revealed square
-                auto neighbors = getNeighbors(r, c, rows, cols);
-                
-                for (const auto& neighbor : neighbors) {
-                    int nr = neighbor.first;
-                    int nc = neighbor.second;
-                    
-                    if (state[nr][nc] == SolverConstants::UNREVEALED && 
-                        !unrevealed_indices.contains_key(nr * cols + nc)) {
-                        unrevealed_indices.insert(nr * cols + nc, index_counter);
-                        index_counter++;
-                    }
-                }
-            }
-        }
-    }
-    return unrevealed_indices;
+struct FrontierPlanes {
+    BitPlane revealed;
+    BitPlane unrevealed;
+    BitPlane frontier;
+    BitPlane sources;  // Revealed cells next to the frontier
+};
+
+FrontierPlanes& frontierPlanes() {
+    thread_local FrontierPlanes planes;
+    return planes;
 }
 
-std::vector<std::vector<int>> EquationBuilder::createEquations(const std::vector<std::vector<int>>& state,
-                                                              const TwoWayDict& unrevealed_indices,
-                                                              int rows, int cols) {
-    std::vector<std::vector<int>> equations;
+} // namespace
 
-    for (int r = 0; r < rows; ++r) {
-        for (int c = 0; c < cols; ++c) {
-            if (state[r][c] >= 0) { // Revealed square
-                auto neighbors = getNeighbors(r, c, rows, cols);
-                std::vector<int> neighbor_indices;
-                int mine_count = state[r][c];
+void EquationBuilder::findFrontier(const BoardGrid& state, BitPlane& revealed, BitPlane& frontier) {
+    BitPlane& unrevealed = frontierPlanes().unrevealed;
+    revealed.assign(state, [](int8_t value) { return value >= 0; });
+    unrevealed.assign(state, [](int8_t value) { return value == SolverConstants::UNREVEALED; });
+    frontier.dilate(revealed, state.neighborOffsets());
+    frontier &= unrevealed;
+}
 
-                // Count marked mines and collect unrevealed neighbor indices
-                for (const auto& neighbor : neighbors) {
-                    int nr = neighbor.first;
-                    int nc = neighbor.second;
-                    
-                    if (state[nr][nc] == SolverConstants::MARKED_MINE) {
-                        mine_count--;
-                    } else if (unrevealed_indices.contains_key(nr * cols + nc)) {
-                        neighbor_indices.push_back(unrevealed_indices.get_value(nr * cols + nc));
-                    }
-                }
+void EquationBuilder::buildEquations(const BoardGrid& state,
+                                     TwoWayDict& unrevealed_indices,
+                                     EquationSystem& equations) {
+    unrevealed_indices.reset(static_cast<int>(state.size()));
+    equations.clear(0);
+    const auto& offsets = state.neighborOffsets();
+    int index_counter = 0;
 
-                // Create equation if there are unrevealed neighbors
-                if (!neighbor_indices.empty()) {
-                    std::vector<int> equation(unrevealed_indices.size(), 0);
-                    
-                    // Set coefficients for unrevealed neighbors
-                    for (int idx : neighbor_indices) {
-                        equation[idx] = 1;
-                    }
-                    
-                    equation.push_back(mine_count); // RHS of equation
-                    equations.push_back(equation);
+    // Only revealed squares next to the frontier give equations. Visiting them
+    // in ascending index order keeps the numbering of a row-by-row scan.
+    FrontierPlanes& planes = frontierPlanes();
+    findFrontier(state, planes.revealed, planes.frontier);
+    planes.sources.dilate(planes.frontier, offsets);
+    planes.sources &= planes.revealed;
+
+    planes.sources.forEach([&](int index) {
+        std::array<int, 8> neighbor_indices; // At most one per direction, kept sorted
+        int neighbor_count = 0;
+        int mine_count = state[index];
+
+        // Border cells are neither marked nor unrevealed, so no bounds check is needed.
+        // Variables are numbered in the order they are first seen.
+        for (int offset : offsets) {
+            int neighbor = index + offset;
+            int value = state[neighbor];
+
+            if (value == SolverConstants::MARKED_MINE) {
+                mine_count--;
+            } else if (value == SolverConstants::UNREVEALED) {
+                int variable = unrevealed_indices.find_value(neighbor);
+                if (variable < 0) {
+                    variable = index_counter++;
+                    unrevealed_indices.insert(neighbor, variable);
+                }
+                // Insertion sort as the variables arrive; there are at most eight
+                int k = neighbor_count++;
+                for (; k > 0 && neighbor_indices[k - 1] > variable; --k) {
+                    neighbor_indices[k] = neighbor_indices[k - 1];
                 }
+                neighbor_indices[k] = variable;
             }
         }
-    }
-    return equations;
-}
 
-std::vector<std::pair<int, int>> EquationBuilder::getNeighbors(int r, int c, int rows, int cols) {
-    std::vector<std::pair<int, int>> neighbors;
-    
-    for (const auto& direction : SolverConstants::NEIGHBOR_DIRECTIONS) {
-        int nr = r + direction[0];
-        int nc = c + direction[1];
-        
-        if (isValidPosition(nr, nc, rows, cols)) {
-            neighbors.emplace_back(nr, nc);
+        for (int k = 0; k < neighbor_count; ++k) {
+            equations.addTerm(neighbor_indices[k], 1);
         }
-    }
-    
-    return neighbors;
-}
-
-bool EquationBuilder::isValidPosition(int r, int c, int rows, int cols) {
-    return r >= 0 && r < rows && c >= 0 && c < cols;
+        equations.finishEquation(mine_count); // RHS of equation
+    });
+    equations.setVariableCount(index_counter);
 }
@@ -2,7 +2,10 @@
 #define EQUATION_BUILDER_HPP
 
 #include <vector>
+#include "board_grid.hpp"
+#include "bit_plane.hpp"
 #include "two_way_dict.hpp"
+#include "equation_system.hpp"
 #include "solver_constants.hpp"
 
 /**
@@ -13,47 +16,26 @@
 class EquationBuilder {
 public:
     /**
-     * Identify all unrevealed squares that are adjacent to revealed squares.
+     * Find the frontier with bitplane dilation, 64 cells at a time.
      * @param state The current board state
-     * @param rows Number of rows in the board
-     * @param cols Number of columns in the board
-     * @return A TwoWayDict mapping board positions to equation indices
+     * @param revealed Output plane of the revealed (numbered) cells
+     * @param frontier Output plane of the unrevealed cells adjacent to a revealed cell
      */
-    static TwoWayDict identifyUnrevealedSquares(const std::vector<std::vector<int>>& state, 
-                                               int rows, int cols);
+    static void findFrontier(const BoardGrid& state, BitPlane& revealed, BitPlane& frontier);
 
     /**
-     * Create linear equations from the board state.
+     * Find the frontier and create its constraint equations.
+     * Every unrevealed square adjacent to a revealed square becomes a variable, numbered
+     * in the order it is first seen; every revealed square with unrevealed neighbors
+     * gives one equation. Only revealed squares next to the frontier are visited.
      * @param state The current board state
-     * @param unrevealed_indices Mapping of unrevealed squares to equation indices
-     * @param rows Number of rows in the board
-     * @param cols Number of columns in the board
-     * @return Vector of equations, where each equation is a vector of coefficients
+     * @param unrevealed_indices Output mapping of board cell indices to variable indices;
+     *                           reset first, its storage is reused
+     * @param equations Output system; cleared first, its storage is reused
      */
-    static std::vector<std::vector<int>> createEquations(const std::vector<std::vector<int>>& state,
-                                                         const TwoWayDict& unrevealed_indices,
-                                                         int rows, int cols);
-
-private:
-    /**
-     * Get all neighbors of a cell at position (r, c).
-     * @param r Row index
-     * @param c Column index
-     * @param rows Total number of rows
-     * @param cols Total number of columns
-     * @return Vector of (row, col) pairs representing valid neighbors
-     */
-    static std::vector<std::pair<int, int>> getNeighbors(int r, int c, int rows, int cols);
-
-    /**
-     * Check if a position is within board bounds.
-     * @param r Row index
-     * @param c Column index
-     * @param rows Total number of rows
-     * @param cols Total number of columns
-     * @return True if position is valid, false otherwise
-     */
-    static bool isValidPosition(int r, int c, int rows, int cols);
+    static void buildEquations(const BoardGrid& state,
+                               TwoWayDict& unrevealed_indices,
+                               EquationSystem& equations);
 };
 
 #endif // EQUATION_BUILDER_HPP
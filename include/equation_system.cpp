@@ -0,0 +1,52 @@
+#include "equation_system.hpp"
+
+EquationSystem::EquationSystem(int variableCount) {
+    clear(variableCount);
+}
+
+void EquationSystem::clear(int variableCount) {
+    variable_count = variableCount;
+    row_offsets.clear();
+    row_offsets.push_back(0);
+    column_indices.clear();
+    values.clear();
+    rhs_values.clear();
+}
+
+void EquationSystem::setVariableCount(int variableCount) {
+    variable_count = variableCount;
+}
+
+void EquationSystem::addTerm(int column, int coefficient) {
+    column_indices.push_back(column);
+    values.push_back(coefficient);
+}
+
+void EquationSystem::finishEquation(int rhs) {
+    rhs_values.push_back(rhs);
+    row_offsets.push_back(static_cast<int>(column_indices.size()));
+}
+
+void EquationSystem::addEquation(const Row& row) {
+    column_indices.insert(column_indices.end(), row.columns, row.columns + row.size);
+    values.insert(values.end(), row.coefficients, row.coefficients + row.size);
+    finishEquation(row.rhs);
+}
+
+int EquationSystem::equationCount() const {
+    return static_cast<int>(rhs_values.size());
+}
+
+int EquationSystem::variableCount() const {
+    return variable_count;
+}
+
+size_t EquationSystem::nonZeroCount() const {
+    return column_indices.size();
+}
+
+EquationSystem::Row EquationSystem::equation(int index) const {
+    int begin = row_offsets[index];
+    int end = row_offsets[index + 1];
+    return Row{column_indices.data() + begin, values.data() + begin, end - begin, rhs_values[index]};
+}
@@ -0,0 +1,96 @@
+#ifndef EQUATION_SYSTEM_HPP
+#define EQUATION_SYSTEM_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Sparse linear equation system stored in compressed sparse row (CSR) form.
+ * Each equation keeps only its nonzero coefficients, sorted by column, plus its
+ * right-hand side. Storage therefore scales with the number of nonzeros rather
+ * than with equations * variables.
+ */
+class EquationSystem {
+public:
+    /**
+     * Read-only view of a single equation.
+     */
+    struct Row {
+        const int* columns;      // Variable indices, ascending
+        const int* coefficients; // Coefficient for each entry of columns
+        int size;                // Number of nonzero coefficients
+        int rhs;                 // Right-hand side
+    };
+
+    /**
+     * Create an empty system.
+     * @param variableCount Number of variables (columns, excluding the RHS)
+     */
+    explicit EquationSystem(int variableCount = 0);
+
+    /**
+     * Remove all equations while keeping allocated storage.
+     * @param variableCount Number of variables for the new system
+     */
+    void clear(int variableCount);
+
+    /**
+     * Set the number of variables, for builders that discover variables while adding equations.
+     * @param variableCount Number of variables; must exceed every column index added
+     */
+    void setVariableCount(int variableCount);
+
+    /**
+     * Append a term to the equation currently being built.
+     * Terms must be added in ascending column order and coefficients must be nonzero.
+     * @param column Variable index
+     * @param coefficient Coefficient of the variable
+     */
+    void addTerm(int column, int coefficient);
+
+    /**
+     * Close the equation currently being built.
+     * @param rhs Right-hand side of the equation
+     */
+    void finishEquation(int rhs);
+
+    /**
+     * Copy an equation from another system.
+     * @param row The equation to append
+     */
+    void addEquation(const Row& row);
+
+    /**
+     * Get the number of equations.
+     * @return Number of equations
+     */
+    int equationCount() const;
+
+    /**
+     * Get the number of variables.
+     * @return Number of variables
+     */
+    int variableCount() const;
+
+    /**
+     * Get the number of stored nonzero coefficients.
+     * @return Number of nonzeros
+     */
+    size_t nonZeroCount() const;
+
+    /**
+     * Get a view of an equation.
+     * @param index Equation index
+     * @return View into the system's storage, invalidated when the system is modified
+     */
+    Row equation(int index) const;
+
+private:
+    int variable_count;
+    std::vector<int> row_offsets;  // equationCount() + 1 offsets into columns/coefficients
+    std::vector<int> column_indices;
+    std::vector<int> values;
+    std::vector<int> rhs_values;
+};
+
+#endif // EQUATION_SYSTEM_HPP
@@ -0,0 +1,66 @@
+#include "frontier_components.hpp"
+#include "union_find.hpp"
+
+std::vector<EquationComponent> FrontierComponents::split(const EquationSystem& system) {
+    std::vector<EquationComponent> components;
+    Scratch scratch;
+    split(system, components, scratch);
+    return components;
+}
+
+void FrontierComponents::split(const EquationSystem& system,
+                               std::vector<EquationComponent>& components,
+                               Scratch& scratch) {
+    const int variableCount = system.variableCount();
+    UnionFind& sets = scratch.sets;
+    sets.reset(variableCount);
+
+    // Every equation connects all of its variables
+    for (int i = 0; i < system.equationCount(); ++i) {
+        EquationSystem::Row equation = system.equation(i);
+        for (int k = 1; k < equation.size; ++k) {
+            sets.unite(equation.columns[0], equation.columns[k]);
+        }
+    }
+
+    // Number the components by their smallest variable and assign local indices.
+    // Scanning variables in ascending order keeps each component's columns ascending.
+    // Existing components are cleared rather than destroyed so their storage is reused
+    std::vector<int>& component_of_root = scratch.component_of_root;
+    std::vector<int>& local_index = scratch.local_index;
+    std::vector<int>& variable_component = scratch.variable_component;
+    component_of_root.assign(variableCount, -1);
+    local_index.assign(variableCount, -1);
+    variable_component.assign(variableCount, -1);
+    size_t count = 0;
+
+    for (int var = 0; var < variableCount; ++var) {
+        int root = sets.find(var);
+        if (component_of_root[root] < 0) {
+            component_of_root[root] = static_cast<int>(count);
+            if (count == components.size()) components.emplace_back();
+            components[count].variables.clear();
+            ++count;
+        }
+        EquationComponent& component = components[component_of_root[root]];
+        variable_component[var] = component_of_root[root];
+        local_index[var] = static_cast<int>(component.variables.size());
+        component.variables.push_back(var);
+    }
+    components.resize(count);
+
+    for (auto& component : components) {
+        component.equations.clear(static_cast<int>(component.variables.size()));
+    }
+
+    for (int i = 0; i < system.equationCount(); ++i) {
+        EquationSystem::Row equation = system.equation(i);
+        if (equation.size == 0) continue; // Belongs to no component
+
+        EquationSystem& target = components[variable_component[equation.columns[0]]].equations;
+        for (int k = 0; k < equation.size; ++k) {
+            target.addTerm(local_index[equation.columns[k]], equation.coefficients[k]);
+        }
+        target.finishEquation(equation.rhs);
+    }
+}
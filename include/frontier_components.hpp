@@ -0,0 +1,54 @@
+#ifndef FRONTIER_COMPONENTS_HPP
+#define FRONTIER_COMPONENTS_HPP
+
+#include <vector>
+#include "equation_system.hpp"
+#include "union_find.hpp"
+
+/**
+ * An independent block of the constraint system.
+ * No variable of one component appears in an equation of another.
+ */
+struct EquationComponent {
+    EquationSystem equations;    // Equations of the block, with local column indices
+    std::vector<int> variables;  // Global variable index of each local column, ascending
+};
+
+/**
+ * Helper class for splitting the frontier's equation system into connected
+ * components. Two variables are connected when they appear in the same
+ * equation, so each component can be reduced independently.
+ */
+class FrontierComponents {
+public:
+    /**
+     * Working storage for split(), kept by the caller between calls.
+     */
+    struct Scratch {
+        UnionFind sets;
+        std::vector<int> component_of_root;   // Component of each union-find root, -1 if none yet
+        std::vector<int> local_index;         // Local column of each global variable
+        std::vector<int> variable_component;  // Component of each global variable
+    };
+
+    /**
+     * Split a system into its connected components using union-find over shared variables.
+     * Components are ordered by their smallest variable; equations keep their original order.
+     * @param system The equation system over global variable indices
+     * @return The independent blocks of the system
+     */
+    static std::vector<EquationComponent> split(const EquationSystem& system);
+
+    /**
+     * Split a system into its connected components, reusing the storage of an
+     * earlier result. Same result as the overload above.
+     * @param system The equation system over global variable indices
+     * @param components Output blocks; existing elements are overwritten in place
+     * @param scratch Working storage reused between calls
+     */
+    static void split(const EquationSystem& system,
+                      std::vector<EquationComponent>& components,
+                      Scratch& scratch);
+};
+
+#endif // FRONTIER_COMPONENTS_HPP
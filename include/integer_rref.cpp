@@ -0,0 +1,592 @@
+#include "integer_rref.hpp"
+#include "big_int.hpp"
+#include "aligned_allocator.hpp"
+#include "row_kernels.hpp"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * Arithmetic for the 64-bit engine. Every operation reports overflow instead of wrapping.
+ * INT64_MIN is treated as an overflow so that negation and abs are always safe.
+ *
+ * Rows are stored with a padded, 64-byte aligned stride. A bound on |entry| is
+ * kept per row so that updates whose operands all fit in 32 bits can use the
+ * unchecked SIMD kernels in RowKernels.
+ */
+struct Int64Ops {
+    using Number = int64_t;
+    using Storage = std::vector<int64_t, AlignedAllocator<int64_t>>;
+
+    std::vector<int64_t> row_bound; // max |entry| of each row
+
+    static Number fromInt(int value) { return value; }
+
+    static bool mulSub(Number p, Number x, Number a, Number y, Number& out) {
+        Number px, ay;
+        if (__builtin_mul_overflow(p, x, &px)) return false;
+        if (__builtin_mul_overflow(a, y, &ay)) return false;
+        if (__builtin_sub_overflow(px, ay, &out)) return false;
+        return out != INT64_MIN;
+    }
+
+    static Number gcd(Number a, Number b) {
+        a = std::llabs(a);
+        b = std::llabs(b);
+        while (b != 0) {
+            Number t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    static bool isZero(Number value) { return value == 0; }
+    static bool isNegative(Number value) { return value < 0; }
+
+    static bool toInt(Number value, int& out) {
+        if (value < INT_MIN || value > INT_MAX) return false;
+        out = static_cast<int>(value);
+        return true;
+    }
+
+    static size_t stride(size_t columnCount) {
+        const size_t alignment = RowKernels::ROW_ALIGNMENT;
+        return (columnCount + alignment - 1) / alignment * alignment;
+    }
+
+    void initialize(const Storage& m, size_t rowCount, size_t columnCount, size_t rowStride) {
+        row_bound.resize(rowCount);
+        for (size_t j = 0; j < rowCount; ++j) {
+            row_bound[j] = RowKernels::maxAbs(&m[j * rowStride], columnCount);
+        }
+    }
+
+    void swapRows(size_t a, size_t b) { std::swap(row_bound[a], row_bound[b]); }
+
+    void rowChanged(Number* row, size_t j, size_t columnCount) {
+        removeContent(row, columnCount);
+        row_bound[j] = RowKernels::maxAbs(row, columnCount);
+    }
+
+    bool updateRow(Number* row, size_t j, const Number* pivotRow, size_t r,
+                   Number p, Number a, size_t lead, size_t columnCount) {
+        if (!mulSubRange(row, pivotRow, p, a, firstColumn(p, lead), columnCount, fitsKernel(j, r, p, a))) {
+            return false;
+        }
+        rowChanged(row, j, columnCount);
+        return true;
+    }
+
+    /**
+     * The pivot row is zero left of lead, so with p == 1 those columns are unchanged.
+     * @return First column an update by this pivot has to touch
+     */
+    static size_t firstColumn(Number p, size_t lead) { return p == 1 ? lead : 0; }
+
+    /**
+     * @return True if row j minus a times pivot row r can use the unchecked SIMD kernel
+     */
+    bool fitsKernel(size_t j, size_t r, Number p, Number a) const {
+        const int64_t limit = RowKernels::SMALL_ENTRY_LIMIT;
+        return row_bound[j] < limit && row_bound[r] < limit && p < limit && std::llabs(a) < limit;
+    }
+
+    /**
+     * row[begin, end) = p * row - a * pivotRow, without content removal.
+     * @return False on overflow (only possible when small is false)
+     */
+    static bool mulSubRange(Number* row, const Number* pivotRow, Number p, Number a,
+                            size_t begin, size_t end, bool small) {
+        if (small) {
+            RowKernels::mulSub(row, pivotRow, p, a, begin, end);
+            return true;
+        }
+        for (size_t c = begin; c < end; ++c) {
+            if (!mulSub(p, row[c], a, pivotRow[c], row[c])) return false;
+        }
+        return true;
+    }
+
+    static void removeContent(Number* row, size_t cols) {
+        Number g = 0;
+        for (size_t c = 0; c < cols; ++c) {
+            if (row[c] == 0) continue;
+            g = gcd(g, row[c]);
+            if (g == 1) return;
+        }
+        if (g == 0) return;
+        for (size_t c = 0; c < cols; ++c) {
+            row[c] /= g;
+        }
+    }
+};
+
+/**
+ * Arithmetic for the arbitrary precision fallback. Never overflows.
+ */
+struct BigIntOps {
+    using Number = BigInt;
+    using Storage = std::vector<BigInt>;
+
+    static Number fromInt(int value) { return BigInt(value); }
+
+    static Number gcd(const Number& a, const Number& b) { return BigInt::gcd(a, b); }
+
+    static bool isZero(const Number& value) { return value.isZero(); }
+    static bool isNegative(const Number& value) { return value.sign() < 0; }
+
+    static bool toInt(const Number& value, int& out) {
+        if (!value.fitsIn(INT_MIN, INT_MAX)) return false;
+        out = static_cast<int>(value.toInt64());
+        return true;
+    }
+
+    static size_t stride(size_t columnCount) { return columnCount; }
+
+    void initialize(const Storage&, size_t, size_t, size_t) {}
+
+    void swapRows(size_t, size_t) {}
+
+    void rowChanged(Number* row, size_t, size_t columnCount) {
+        removeContent(row, columnCount);
+    }
+
+    bool updateRow(Number* row, size_t j, const Number* pivotRow, size_t,
+                   const Number& p, const Number& a, size_t, size_t columnCount) {
+        for (size_t c = 0; c < columnCount; ++c) {
+            row[c] = p * row[c] - a * pivotRow[c];
+        }
+        rowChanged(row, j, columnCount);
+        return true;
+    }
+
+    static void removeContent(Number* row, size_t cols) {
+        Number g = fromInt(0);
+        for (size_t c = 0; c < cols; ++c) {
+            if (row[c].isZero()) continue;
+            g = gcd(g, row[c]);
+            if (g == BigInt(1)) return;
+        }
+        if (g.isZero()) return;
+        for (size_t c = 0; c < cols; ++c) {
+            if (!row[c].isZero()) row[c] = row[c] / g;
+        }
+    }
+};
+
+/**
+ * Fraction-free Gauss-Jordan elimination on a row-major matrix.
+ * Rows whose entry in the pivot column is already zero are skipped.
+ * @return False if the number type overflowed, in which case the matrix contents are unspecified
+ */
+template <typename Ops>
+bool reduce(Ops& ops, typename Ops::Storage& m, size_t rowCount, size_t columnCount, size_t rowStride) {
+    using Number = typename Ops::Number;
+    const size_t coefficientCount = columnCount - 1; // The RHS is never a pivot column
+    size_t lead = 0;
+
+    ops.initialize(m, rowCount, columnCount, rowStride);
+
+    for (size_t r = 0; r < rowCount; ++r) {
+        // Find the next column with a nonzero entry at or below row r
+        size_t i = r;
+        while (lead < coefficientCount) {
+            for (i = r; i < rowCount; ++i) {
+                if (!Ops::isZero(m[i * rowStride + lead])) break;
+            }
+            if (i < rowCount) break;
+            ++lead;
+        }
+        if (lead >= coefficientCount) return true;
+
+        Number* pivotRow = &m[r * rowStride];
+        if (i != r) {
+            Number* other = &m[i * rowStride];
+            for (size_t c = 0; c < columnCount; ++c) std::swap(pivotRow[c], other[c]);
+            ops.swapRows(i, r);
+        }
+        if (Ops::isNegative(pivotRow[lead])) {
+            for (size_t c = 0; c < columnCount; ++c) pivotRow[c] = -pivotRow[c];
+        }
+        ops.rowChanged(pivotRow, r, columnCount);
+
+        const Number p = pivotRow[lead];
+        for (size_t j = 0; j < rowCount; ++j) {
+            if (j == r) continue;
+            Number* row = &m[j * rowStride];
+            if (Ops::isZero(row[lead])) continue; // Nothing to eliminate
+
+            const Number a = row[lead];
+            if (!ops.updateRow(row, j, pivotRow, r, p, a, lead, columnCount)) {
+                return false;
+            }
+        }
+        ++lead;
+    }
+    return true;
+}
+
+/**
+ * Barrier for the elimination team. The phases between barriers are short, so
+ * waiting threads yield instead of sleeping on a condition variable.
+ */
+class SpinBarrier {
+public:
+    explicit SpinBarrier(unsigned count) : count(count) {}
+
+    void wait() {
+        const unsigned generation = current_generation.load(std::memory_order_acquire);
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            arrived.store(0, std::memory_order_relaxed);
+            current_generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        while (current_generation.load(std::memory_order_acquire) == generation) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    const unsigned count;
+    std::atomic<unsigned> arrived{0};
+    std::atomic<unsigned> current_generation{0};
+};
+
+/**
+ * A row one team member updates against the current pivot row.
+ */
+struct EliminationTarget {
+    size_t row;
+    int64_t multiplier;
+    bool small;
+};
+
+/**
+ * Worker threads for reduceParallel, kept between reductions so that a stream
+ * of large systems does not start a new team for each one. Workers sleep on a
+ * condition variable between runs. Each member also keeps its list of target
+ * rows here, so the per-pivot updates allocate nothing once it has grown.
+ * A team is driven by one thread at a time.
+ */
+class EliminationTeam {
+public:
+    EliminationTeam() = default;
+    EliminationTeam(const EliminationTeam&) = delete;
+    EliminationTeam& operator=(const EliminationTeam&) = delete;
+
+    ~EliminationTeam() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * Run member(id) for every id in [0, count) and wait for all of them:
+     * id 0 on the calling thread, the others on workers, started on first use.
+     */
+    void run(unsigned count, const std::function<void(unsigned)>& member) {
+        if (targets.size() < count) targets.resize(count);
+        while (workers.size() + 1 < count) {
+            workers.emplace_back(&EliminationTeam::workerLoop, this,
+                                 static_cast<unsigned>(workers.size() + 1), generation);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = &member;
+            members = count;
+            pending = count - 1;
+            ++generation;
+        }
+        wake.notify_all();
+        member(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+    }
+
+    /**
+     * Get a member's scratch list of target rows.
+     */
+    std::vector<EliminationTarget>& memberTargets(unsigned id) { return targets[id]; }
+
+private:
+    std::vector<std::thread> workers;               // workers[i] is member i + 1
+    std::vector<std::vector<EliminationTarget>> targets;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(unsigned)>* task = nullptr;
+    unsigned members = 0;   // Members of the current run, the caller included
+    unsigned pending = 0;   // Workers of the current run still working
+    size_t generation = 0;  // Runs started so far
+    bool stopping = false;
+
+    void workerLoop(unsigned id, size_t seen) {
+        while (true) {
+            const std::function<void(unsigned)>* current;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || (generation != seen && id < members); });
+                if (stopping) return;
+                seen = generation;
+                current = task;
+            }
+            (*current)(id);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) done.notify_one();
+        }
+    }
+};
+
+/**
+ * Bring the next pivot to row r: find the leftmost column at or after lead with a
+ * nonzero entry at or below r, swap that row up and make the pivot positive.
+ * @return False if no pivot is left
+ */
+bool choosePivot(Int64Ops& ops, Int64Ops::Storage& m, size_t r, size_t& lead,
+                 size_t rowCount, size_t columnCount, size_t rowStride) {
+    const size_t coefficientCount = columnCount - 1;
+    size_t i = r;
+    while (lead < coefficientCount) {
+        for (i = r; i < rowCount; ++i) {
+            if (m[i * rowStride + lead] != 0) break;
+        }
+        if (i < rowCount) break;
+        ++lead;
+    }
+    if (lead >= coefficientCount) return false;
+
+    int64_t* pivotRow = &m[r * rowStride];
+    if (i != r) {
+        std::swap_ranges(pivotRow, pivotRow + columnCount, &m[i * rowStride]);
+        ops.swapRows(i, r);
+    }
+    if (pivotRow[lead] < 0) {
+        for (size_t c = 0; c < columnCount; ++c) pivotRow[c] = -pivotRow[c];
+    }
+    ops.rowChanged(pivotRow, r, columnCount);
+    return true;
+}
+
+/**
+ * Apply pivot row r to the rows owned by one thread of the team.
+ * targets is the member's scratch list from EliminationTeam.
+ *
+ * Rows are dealt out in blocks of ELIMINATION_ROW_BLOCK, round robin, so the
+ * shrinking set of rows with a nonzero in the pivot column stays spread over
+ * all threads. The update sweeps the columns in tiles of
+ * ELIMINATION_TILE_COLUMNS so the slice of the pivot row stays in L1 while
+ * every owned row is updated against it.
+ * @return False on overflow
+ */
+bool eliminateOwnedRows(Int64Ops& ops, Int64Ops::Storage& m, size_t r, size_t lead,
+                        size_t rowCount, size_t columnCount, size_t rowStride,
+                        unsigned id, unsigned threadCount, std::vector<EliminationTarget>& targets) {
+    const int64_t* pivotRow = &m[r * rowStride];
+    const int64_t p = pivotRow[lead];
+    const size_t block = IntegerRREF::ELIMINATION_ROW_BLOCK;
+
+    // Multipliers have to be read before the tile containing lead overwrites them
+    targets.clear();
+    for (size_t first = id * block; first < rowCount; first += threadCount * block) {
+        const size_t last = std::min(first + block, rowCount);
+        for (size_t j = first; j < last; ++j) {
+            const int64_t a = m[j * rowStride + lead];
+            if (j == r || a == 0) continue;
+            targets.push_back({j, a, ops.fitsKernel(j, r, p, a)});
+        }
+    }
+
+    const size_t tile = IntegerRREF::ELIMINATION_TILE_COLUMNS;
+    for (size_t begin = Int64Ops::firstColumn(p, lead); begin < columnCount; begin += tile) {
+        const size_t end = std::min(begin + tile, columnCount);
+        for (const EliminationTarget& target : targets) {
+            if (!Int64Ops::mulSubRange(&m[target.row * rowStride], pivotRow, p, target.multiplier,
+                                       begin, end, target.small)) {
+                return false;
+            }
+        }
+    }
+    for (const EliminationTarget& target : targets) {
+        ops.rowChanged(&m[target.row * rowStride], target.row, columnCount);
+    }
+    return true;
+}
+
+/**
+ * Fraction-free Gauss-Jordan elimination for large systems, with the row updates
+ * of every pivot split across a team of threads. The calling thread is member 0
+ * and also picks the pivots; the team meets at a barrier before and after each
+ * round of updates. Produces exactly the same matrix as reduce<Int64Ops>.
+ * @return False on overflow, in which case the matrix contents are unspecified
+ */
+bool reduceParallel(Int64Ops& ops, Int64Ops::Storage& m, size_t rowCount, size_t columnCount,
+                    size_t rowStride, unsigned threadCount, EliminationTeam& team) {
+    ops.initialize(m, rowCount, columnCount, rowStride);
+
+    SpinBarrier barrier(threadCount);
+    std::atomic<bool> overflow{false};
+    bool finished = false; // Written by member 0 only, between barriers
+    size_t lead = 0;
+
+    auto member = [&](unsigned id) {
+        std::vector<EliminationTarget>& targets = team.memberTargets(id);
+        for (size_t r = 0; r < rowCount; ++r) {
+            if (id == 0) {
+                finished = overflow.load(std::memory_order_relaxed) ||
+                           !choosePivot(ops, m, r, lead, rowCount, columnCount, rowStride);
+            }
+            barrier.wait();
+            if (finished) return;
+
+            if (!eliminateOwnedRows(ops, m, r, lead, rowCount, columnCount, rowStride, id, threadCount,
+                                    targets)) {
+                overflow.store(true, std::memory_order_relaxed);
+            }
+            barrier.wait();
+            if (id == 0) ++lead;
+        }
+    };
+
+    team.run(threadCount, member);
+    return !overflow.load();
+}
+
+/**
+ * Reduce the matrix with the blocked parallel elimination when it is large
+ * enough, and with the plain serial loop otherwise.
+ */
+template <typename Ops>
+bool reduceMatrix(Ops& ops, typename Ops::Storage& m, size_t rowCount, size_t columnCount,
+                  size_t rowStride, unsigned, std::unique_ptr<EliminationTeam>&) {
+    return reduce<Ops>(ops, m, rowCount, columnCount, rowStride);
+}
+
+template <>
+bool reduceMatrix<Int64Ops>(Int64Ops& ops, Int64Ops::Storage& m, size_t rowCount, size_t columnCount,
+                            size_t rowStride, unsigned threadCount,
+                            std::unique_ptr<EliminationTeam>& team) {
+    if (rowCount * columnCount < IntegerRREF::PARALLEL_ELIMINATION_MIN_ENTRIES) {
+        return reduce<Int64Ops>(ops, m, rowCount, columnCount, rowStride);
+    }
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Every member should own at least one block of rows
+    const size_t blocks = (rowCount + IntegerRREF::ELIMINATION_ROW_BLOCK - 1) / IntegerRREF::ELIMINATION_ROW_BLOCK;
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, blocks));
+    if (!team) team.reset(new EliminationTeam);
+    return reduceParallel(ops, m, rowCount, columnCount, rowStride, threadCount, *team);
+}
+
+/**
+ * Buffers kept between calls: the dense matrix, the row bounds, the gather scratch
+ * and, for the 64-bit engine, the parallel elimination team.
+ */
+template <typename Ops>
+struct Buffers {
+    Ops ops;
+    typename Ops::Storage matrix;
+    std::vector<int> columns;
+    std::vector<int> coefficients;
+    std::unique_ptr<EliminationTeam> team;
+};
+
+/**
+ * Scatter the sparse equations into a dense matrix, reduce it and gather the nonzero rows.
+ * The matrix is reassigned in place, so its capacity carries over between calls.
+ * @return False if the number type overflowed
+ */
+template <typename Ops>
+bool computeWith(const EquationSystem& equations, EquationSystem& result, Buffers<Ops>& buffers,
+                 unsigned threadCount) {
+    const size_t rowCount = equations.equationCount();
+    const size_t variableCount = equations.variableCount();
+    const size_t columnCount = variableCount + 1;
+    const size_t rowStride = Ops::stride(columnCount);
+
+    typename Ops::Storage& m = buffers.matrix;
+    m.assign(rowCount * rowStride, Ops::fromInt(0));
+    for (size_t i = 0; i < rowCount; ++i) {
+        EquationSystem::Row equation = equations.equation(static_cast<int>(i));
+        typename Ops::Number* row = &m[i * rowStride];
+        for (int k = 0; k < equation.size; ++k) {
+            row[equation.columns[k]] = Ops::fromInt(equation.coefficients[k]);
+        }
+        row[variableCount] = Ops::fromInt(equation.rhs);
+    }
+
+    if (!reduceMatrix<Ops>(buffers.ops, m, rowCount, columnCount, rowStride, threadCount, buffers.team)) {
+        return false;
+    }
+
+    result.clear(static_cast<int>(variableCount));
+    std::vector<int>& columns = buffers.columns;
+    std::vector<int>& coefficients = buffers.coefficients;
+    for (size_t i = 0; i < rowCount; ++i) {
+        const typename Ops::Number* row = &m[i * rowStride];
+        columns.clear();
+        coefficients.clear();
+        int rhs = 0;
+        bool representable = Ops::toInt(row[variableCount], rhs);
+        for (size_t j = 0; j < variableCount && representable; ++j) {
+            if (Ops::isZero(row[j])) continue;
+            int value = 0;
+            representable = Ops::toInt(row[j], value);
+            columns.push_back(static_cast<int>(j));
+            coefficients.push_back(value);
+        }
+        if (representable && (!columns.empty() || rhs != 0)) {
+            result.addEquation(EquationSystem::Row{columns.data(), coefficients.data(),
+                                                   static_cast<int>(columns.size()), rhs});
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+struct IntegerRREF::Workspace::State {
+    Buffers<Int64Ops> exact;
+};
+
+IntegerRREF::Workspace::Workspace() : state(new State) {}
+
+IntegerRREF::Workspace::~Workspace() = default;
+
+EquationSystem IntegerRREF::compute(const EquationSystem& equations, unsigned threadCount) {
+    Workspace workspace;
+    EquationSystem result;
+    compute(equations, result, workspace, threadCount);
+    return result;
+}
+
+void IntegerRREF::compute(const EquationSystem& equations, EquationSystem& result, Workspace& workspace,
+                          unsigned threadCount) {
+    result.clear(equations.variableCount());
+    if (equations.equationCount() == 0 || equations.variableCount() == 0) {
+        return;
+    }
+
+    if (!computeWith<Int64Ops>(equations, result, workspace.state->exact, threadCount)) {
+        // Overflow is rare, so the BigInt buffers are not worth keeping
+        Buffers<BigIntOps> fallback;
+        computeWith<BigIntOps>(equations, result, fallback, threadCount);
+    }
+}
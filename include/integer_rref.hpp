@@ -0,0 +1,78 @@
+#ifndef INTEGER_RREF_HPP
+#define INTEGER_RREF_HPP
+
+#include <cstddef>
+#include <memory>
+#include "equation_system.hpp"
+
+/**
+ * Exact row reduction of integer augmented matrices.
+ *
+ * Elimination is fraction-free: a row update is
+ * row_j = p * row_j - a * row_r, where p is the pivot and a the entry being
+ * cleared, after which row_j is divided by its content (the gcd of its entries).
+ * Dividing by the content subsumes Bareiss' exact division by the previous
+ * pivot and keeps entries small. Every output row is therefore an integer
+ * multiple of the corresponding row of the rational RREF, which is all the
+ * min/max deduction in RREFProcessor needs.
+ *
+ * Work is done in 64-bit integers; if any operation would overflow, the
+ * reduction is restarted with BigInt entries.
+ *
+ * Systems with at least PARALLEL_ELIMINATION_MIN_ENTRIES matrix entries use a
+ * blocked elimination in which the row updates of each pivot are split across
+ * a team of threads. The result is the same as that of the serial loop.
+ */
+class IntegerRREF {
+public:
+    // Matrix size (rows * columns, RHS included) from which elimination runs in parallel
+    static constexpr size_t PARALLEL_ELIMINATION_MIN_ENTRIES = size_t(1) << 19;
+
+    // Rows are handed to the threads in blocks of this many consecutive rows
+    static constexpr size_t ELIMINATION_ROW_BLOCK = 16;
+
+    // Width of the column tiles in the parallel elimination (16 KiB of int64 entries)
+    static constexpr size_t ELIMINATION_TILE_COLUMNS = 2048;
+
+    /**
+     * Dense matrix, scratch buffers and parallel elimination threads reused
+     * across compute() calls, so that reducing a stream of similarly sized
+     * systems allocates nothing and starts no threads once the buffers have
+     * grown. A workspace must not be shared between threads.
+     */
+    class Workspace {
+    public:
+        Workspace();
+        ~Workspace();
+
+    private:
+        friend class IntegerRREF;
+        struct State;
+        std::unique_ptr<State> state;
+    };
+
+    /**
+     * Compute the reduced row echelon form of an equation system.
+     * The right-hand side is never chosen as a pivot column.
+     * Zero rows are dropped from the result, as are rows that cannot be represented in int
+     * (which only happens after a BigInt fallback).
+     * @param equations The sparse equation system
+     * @param threadCount Maximum number of threads for a parallel elimination, 0 for the
+     *                    hardware concurrency. Ignored below PARALLEL_ELIMINATION_MIN_ENTRIES.
+     * @return The reduced equations, each with a positive pivot and content 1
+     */
+    static EquationSystem compute(const EquationSystem& equations, unsigned threadCount = 0);
+
+    /**
+     * Compute the reduced row echelon form into an existing system, reusing the
+     * workspace's buffers. Same result as the overload above.
+     * @param equations The sparse equation system
+     * @param result Output system; cleared first, its storage is reused
+     * @param workspace Buffers kept between calls by the caller
+     * @param threadCount As for the overload above
+     */
+    static void compute(const EquationSystem& equations, EquationSystem& result, Workspace& workspace,
+                        unsigned threadCount = 0);
+};
+
+#endif // INTEGER_RREF_HPP
@@ -0,0 +1,371 @@
+#include "mine_probability.hpp"
+#include "solver_constants.hpp"
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+/**
+ * Natural log of the binomial coefficient C(n, r).
+ * @return -infinity when r is outside [0, n]
+ */
+double logBinomial(int n, int r) {
+    if (r < 0 || r > n) return -std::numeric_limits<double>::infinity();
+    return std::lgamma(n + 1.0) - std::lgamma(r + 1.0) - std::lgamma(n - r + 1.0);
+}
+
+/**
+ * Multiply two polynomials in the mine count. Only ratios of the result are
+ * used, so it is scaled to a largest coefficient of 1 to stay in range.
+ */
+void convolve(const std::vector<double>& a, const std::vector<double>& b, std::vector<double>& product) {
+    product.assign(a.size() + b.size() - 1, 0.0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] == 0) continue;
+        for (size_t j = 0; j < b.size(); ++j) {
+            product[i + j] += a[i] * b[j];
+        }
+    }
+    double largest = *std::max_element(product.begin(), product.end());
+    if (largest > 0) {
+        for (double& value : product) value /= largest;
+    }
+}
+
+/**
+ * How one layer's states lead to the next layer's when its variable is assigned.
+ */
+struct LayerPlan {
+    struct Check {
+        int rhs;        // Starting residual for an equation that opens on this variable
+        int source;     // Index of the residual in this layer's state, -1 if the equation opens here
+        int target;     // Index in the next layer's state, -1 if the equation closes here
+        int remaining;  // Variables of the equation after this one
+    };
+    std::vector<Check> checks;                   // Equations containing the variable
+    std::vector<std::pair<int, int>> carried;    // (source, target) of open equations without it
+    int width = 0;                               // Residuals in the next layer's state
+};
+
+} // namespace
+
+MineProbability::Stats MineProbability::compute(const std::vector<EquationComponent>& components,
+                                                int variableCount, int interiorCells, int remainingMines,
+                                                WorkStealingPool* pool, std::vector<double>& probabilities,
+                                                double& interior) {
+    Stats stats;
+    const size_t n = components.size();
+    stats.components = static_cast<int>(n);
+    probabilities.clear();
+    interior = 0;
+
+    // Look every component up; only the missing ones are counted
+    keys.resize(n);
+    counts.assign(n, nullptr);
+    std::vector<size_t> missing;
+    std::vector<size_t> costs;
+    size_t missing_variables = 0;
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = key(components[i].equations);
+        auto found = cache.find(keys[i]);
+        if (found != cache.end()) {
+            counts[i] = found->second;
+        } else {
+            size_t variables = components[i].equations.variableCount();
+            missing.push_back(i);
+            costs.push_back(variables * variables);
+            missing_variables += variables;
+        }
+    }
+
+    std::vector<Counts> fresh(missing.size());
+    auto countOne = [&](size_t m) { count(components[missing[m]].equations, fresh[m]); };
+    if (pool && missing.size() > 1 && missing_variables >= SolverConstants::PROBABILITY_PARALLEL_MIN_VARIABLES) {
+        pool->run(costs, countOne);
+    } else {
+        for (size_t m = 0; m < missing.size(); ++m) countOne(m);
+    }
+
+    if (cache.size() + missing.size() > SolverConstants::PROBABILITY_CACHE_LIMIT) {
+        cache.clear();
+    }
+    for (size_t m = 0; m < missing.size(); ++m) {
+        auto shared = std::make_shared<const Counts>(std::move(fresh[m]));
+        stats.states += shared->states;
+        stats.exact = stats.exact && shared->exact;
+        if (shared->exact) cache.emplace(keys[missing[m]], shared);
+        counts[missing[m]] = shared;
+    }
+    stats.counted = static_cast<int>(missing.size());
+    if (!stats.exact) return stats;
+
+    // Layouts of the whole frontier by mine count: the product of the components'
+    std::vector<std::vector<double>> suffix(n + 1);
+    suffix[n] = {1.0};
+    for (size_t i = n; i-- > 0;) {
+        convolve(counts[i]->layouts, suffix[i + 1], suffix[i]);
+    }
+    const std::vector<double>& total = suffix[0];
+
+    // A frontier layout with K mines leaves C(interiorCells, remainingMines - K) ways for the rest
+    std::vector<double> weight(total.size(), 0.0);
+    double largest = -std::numeric_limits<double>::infinity();
+    for (size_t k = 0; k < total.size(); ++k) {
+        weight[k] = logBinomial(interiorCells, remainingMines - static_cast<int>(k));
+        if (total[k] > 0) largest = std::max(largest, weight[k]);
+    }
+    if (!std::isfinite(largest)) {
+        stats.feasible = false; // No layout fits the mine count
+        return stats;
+    }
+    // Mine counts no frontier layout reaches get no weight: theirs can exceed the
+    // largest by so much that exp() overflows, and 0 * inf would poison the sums
+    double z = 0, interior_mines = 0;
+    for (size_t k = 0; k < total.size(); ++k) {
+        weight[k] = total[k] > 0 && std::isfinite(weight[k]) ? std::exp(weight[k] - largest) : 0.0;
+        z += total[k] * weight[k];
+        interior_mines += total[k] * weight[k] * (remainingMines - static_cast<int>(k));
+    }
+    interior = interiorCells > 0 ? interior_mines / (z * interiorCells) : 0;
+
+    // Each component's layouts are weighted by the ways the other components and the
+    // interior can complete them
+    probabilities.assign(variableCount, 0.0);
+    std::vector<double> prefix = {1.0}, others, scratch, completions;
+    for (size_t i = 0; i < n; ++i) {
+        const Counts& component = *counts[i];
+        const int variables = component.variables;
+        convolve(prefix, suffix[i + 1], others);
+
+        completions.assign(variables + 1, 0.0);
+        double component_z = 0;
+        for (int k = 0; k <= variables; ++k) {
+            if (component.layouts[k] == 0) continue;
+            for (size_t j = 0; j < others.size() && k + j < weight.size(); ++j) {
+                completions[k] += others[j] * weight[k + j];
+            }
+            component_z += component.layouts[k] * completions[k];
+        }
+
+        for (int v = 0; v < variables; ++v) {
+            const double* mines = &component.mines[static_cast<size_t>(v) * (variables + 1)];
+            double p = 0;
+            for (int k = 0; k <= variables; ++k) {
+                p += mines[k] * completions[k];
+            }
+            probabilities[components[i].variables[v]] = component_z > 0 ? p / component_z : 0;
+        }
+
+        convolve(prefix, component.layouts, scratch);
+        prefix.swap(scratch);
+    }
+    return stats;
+}
+
+void MineProbability::clearCache() {
+    cache.clear();
+}
+
+std::string MineProbability::key(const EquationSystem& equations) {
+    // Local indices follow the frontier numbering, so an unchanged component
+    // produces the same key from call to call
+    std::string result;
+    auto append = [&](int value) { result.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+    append(equations.variableCount());
+    for (int r = 0; r < equations.equationCount(); ++r) {
+        EquationSystem::Row row = equations.equation(r);
+        append(row.size);
+        append(row.rhs);
+        for (int t = 0; t < row.size; ++t) {
+            append(row.columns[t]);
+        }
+    }
+    return result;
+}
+
+void MineProbability::count(const EquationSystem& equations, Counts& counts) {
+    const int n = equations.variableCount();
+    const int rows = equations.equationCount();
+    counts.variables = n;
+    counts.layouts.assign(n + 1, 0.0);
+    counts.mines.assign(static_cast<size_t>(n) * (n + 1), 0.0);
+
+    const std::vector<int> sequence = order(equations);
+    std::vector<int> position(n);
+    for (int d = 0; d < n; ++d) position[sequence[d]] = d;
+
+    // Equations of each variable, and where each equation starts and ends in the order
+    std::vector<std::vector<int>> rows_of(n);
+    std::vector<int> first(rows, n), last(rows, -1);
+    for (int r = 0; r < rows; ++r) {
+        EquationSystem::Row row = equations.equation(r);
+        for (int t = 0; t < row.size; ++t) {
+            int p = position[row.columns[t]];
+            rows_of[row.columns[t]].push_back(r);
+            first[r] = std::min(first[r], p);
+            last[r] = std::max(last[r], p);
+        }
+    }
+
+    // A layer's state holds the residual of every equation with variables on both sides of it
+    std::vector<LayerPlan> plans(n);
+    std::vector<int> open, next_open, slot(rows, -1), next_slot(rows, -1), seen(rows, 0);
+    for (int d = 0; d < n; ++d) {
+        const int variable = sequence[d];
+        next_open.clear();
+        for (int r : open) {
+            if (last[r] > d) next_open.push_back(r);
+        }
+        for (int r : rows_of[variable]) {
+            if (first[r] == d && last[r] > d) next_open.push_back(r);
+        }
+        std::sort(next_open.begin(), next_open.end());
+        for (size_t t = 0; t < next_open.size(); ++t) next_slot[next_open[t]] = static_cast<int>(t);
+
+        LayerPlan& plan = plans[d];
+        plan.width = static_cast<int>(next_open.size());
+        for (int r : rows_of[variable]) {
+            EquationSystem::Row row = equations.equation(r);
+            int remaining = 0;
+            for (int t = 0; t < row.size; ++t) remaining += position[row.columns[t]] > d;
+            plan.checks.push_back({row.rhs, first[r] == d ? -1 : slot[r], last[r] == d ? -1 : next_slot[r], remaining});
+            seen[r] = d + 1;
+        }
+        for (int r : open) {
+            if (seen[r] != d + 1) plan.carried.push_back({slot[r], next_slot[r]});
+        }
+
+        for (int r : open) slot[r] = -1;
+        open.swap(next_open);
+        for (size_t t = 0; t < open.size(); ++t) slot[open[t]] = next_slot[open[t]];
+    }
+
+    // Forward: ways to reach each state, by the mines placed so far
+    std::vector<std::vector<std::string>> states(n + 1);
+    std::vector<std::vector<std::array<int, 2>>> children(n);
+    std::vector<std::vector<double>> forward(n + 1);
+    states[0] = {std::string()};
+    forward[0] = {1.0};
+    std::unordered_map<std::string, int> index_of;
+    std::string next;
+    for (int d = 0; d < n; ++d) {
+        const LayerPlan& plan = plans[d];
+        index_of.clear();
+        children[d].assign(states[d].size(), {-1, -1});
+        for (size_t s = 0; s < states[d].size(); ++s) {
+            const std::string& current = states[d][s];
+            for (int x = 0; x <= 1; ++x) {
+                next.assign(plan.width, 0);
+                for (const auto& carried : plan.carried) {
+                    next[carried.second] = current[carried.first];
+                }
+                bool feasible = true;
+                for (const auto& check : plan.checks) {
+                    int residual = (check.source < 0 ? check.rhs : current[check.source]) - x;
+                    if (residual < 0 || residual > check.remaining) {
+                        feasible = false;
+                        break;
+                    }
+                    if (check.target >= 0) next[check.target] = static_cast<char>(residual);
+                }
+                if (!feasible) continue;
+
+                auto inserted = index_of.emplace(next, static_cast<int>(states[d + 1].size()));
+                if (inserted.second) {
+                    states[d + 1].push_back(next);
+                    forward[d + 1].resize(forward[d + 1].size() + d + 2, 0.0);
+                }
+                const int child = inserted.first->second;
+                children[d][s][x] = child;
+                const double* from = &forward[d][s * (d + 1)];
+                double* to = &forward[d + 1][child * (d + 2) + x];
+                for (int k = 0; k <= d; ++k) to[k] += from[k];
+            }
+        }
+        counts.states += static_cast<long>(states[d + 1].size());
+        if (counts.states > SolverConstants::PROBABILITY_MAX_STATES) {
+            counts.exact = false;
+            return;
+        }
+    }
+    if (states[n].empty()) return; // The equations contradict each other
+
+    // Backward: ways to complete each state, by the mines still to place
+    std::vector<double> backward = {1.0}, previous;
+    for (int d = n - 1; d >= 0; --d) {
+        const int after = n - d - 1;  // Variables after this one
+        previous.assign(states[d].size() * (after + 2), 0.0);
+        for (size_t s = 0; s < states[d].size(); ++s) {
+            const double* reach = &forward[d][s * (d + 1)];
+            for (int x = 0; x <= 1; ++x) {
+                const int child = children[d][s][x];
+                if (child < 0) continue;
+                const double* complete = &backward[child * (after + 1)];
+                double* mine = &counts.mines[static_cast<size_t>(sequence[d]) * (n + 1)];
+                for (int j = 0; j <= after; ++j) {
+                    if (complete[j] == 0) continue;
+                    previous[s * (after + 2) + j + x] += complete[j];
+                    if (x == 0) continue;
+                    // Layouts through this state with the variable a mine
+                    for (int k = 0; k <= d; ++k) {
+                        mine[k + 1 + j] += reach[k] * complete[j];
+                    }
+                }
+            }
+        }
+        backward.swap(previous);
+    }
+    for (int k = 0; k <= n; ++k) {
+        counts.layouts[k] = backward[k];
+    }
+}
+
+std::vector<int> MineProbability::order(const EquationSystem& equations) {
+    // Cuthill-McKee: breadth-first from a least connected variable, neighbours by
+    // degree, which keeps few equations open at any point of the order
+    const int n = equations.variableCount();
+    std::vector<std::vector<int>> neighbors(n);
+    for (int r = 0; r < equations.equationCount(); ++r) {
+        EquationSystem::Row row = equations.equation(r);
+        for (int a = 0; a < row.size; ++a) {
+            for (int b = 0; b < row.size; ++b) {
+                if (a != b) neighbors[row.columns[a]].push_back(row.columns[b]);
+            }
+        }
+    }
+    for (auto& list : neighbors) {
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+    }
+    auto byDegree = [&](int a, int b) {
+        return neighbors[a].size() != neighbors[b].size() ? neighbors[a].size() < neighbors[b].size() : a < b;
+    };
+
+    std::vector<int> sequence;
+    std::vector<char> visited(n, 0);
+    std::vector<int> candidates;
+    sequence.reserve(n);
+    while (static_cast<int>(sequence.size()) < n) {
+        int start = -1;
+        for (int v = 0; v < n; ++v) {
+            if (!visited[v] && (start < 0 || byDegree(v, start))) start = v;
+        }
+        visited[start] = 1;
+        sequence.push_back(start);
+        for (size_t head = sequence.size() - 1; head < sequence.size(); ++head) {
+            candidates.clear();
+            for (int neighbor : neighbors[sequence[head]]) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = 1;
+                    candidates.push_back(neighbor);
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(), byDegree);
+            sequence.insert(sequence.end(), candidates.begin(), candidates.end());
+        }
+    }
+    return sequence;
+}
@@ -0,0 +1,90 @@
+#ifndef MINE_PROBABILITY_HPP
+#define MINE_PROBABILITY_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "frontier_components.hpp"
+
+// Forward declarations
+class WorkStealingPool;
+
+/**
+ * Exact mine probabilities of the frontier cells and of the cells off it.
+ *
+ * Every frontier component is counted on its own: how many of its mine
+ * layouts satisfy all its equations, split by the number of mines they use,
+ * and for each variable how many of those layouts make it a mine. The count
+ * runs over the variables in a bandwidth-reducing (Cuthill-McKee) order with
+ * one layer per variable; a layer's states are the residual right-hand
+ * sides of the equations that are partly assigned, so layouts that agree on
+ * them are merged rather than enumerated one by one, and a state is dropped
+ * as soon as an equation can no longer be met. A forward pass counts the
+ * ways to reach each state and a backward pass the ways to complete it.
+ *
+ * The components are then combined: a layout with K frontier mines leaves
+ * the other mines to the cells off the frontier, which weights it by the
+ * binomial C(interior cells, remaining mines - K). Weights are kept in log
+ * space, since the binomials overflow a double on large boards.
+ *
+ * Component counts depend only on the component's equations, so they are
+ * cached by them and a component unchanged since an earlier call is not
+ * counted again. Components that are not cached are counted concurrently.
+ */
+class MineProbability {
+public:
+    /**
+     * What one compute() did.
+     */
+    struct Stats {
+        int components = 0;   // Frontier components
+        int counted = 0;      // Components counted by this call; the others came from the cache
+        long states = 0;      // Layer states visited while counting
+        bool exact = true;    // False if a component needed more than PROBABILITY_MAX_STATES states
+        bool feasible = true; // False if no layout fits the equations and the mine count
+    };
+
+    /**
+     * Compute the mine probabilities of a position.
+     * @param components The frontier equations split into components, as from FrontierComponents::split;
+     *                   every coefficient must be 1
+     * @param variableCount Number of frontier variables
+     * @param interiorCells Unrevealed, unmarked cells in no equation
+     * @param remainingMines Mines not yet marked
+     * @param pool Pool to count components on concurrently; nullptr counts on the calling thread
+     * @param probabilities Output probability of each frontier variable; its storage is reused
+     * @param interior Output probability of each cell off the frontier
+     * @return Counts of the work done; unless exact and feasible, the outputs are left empty and 0
+     */
+    Stats compute(const std::vector<EquationComponent>& components, int variableCount,
+                  int interiorCells, int remainingMines, WorkStealingPool* pool,
+                  std::vector<double>& probabilities, double& interior);
+
+    /**
+     * Drop the cached component counts.
+     */
+    void clearCache();
+
+private:
+    /**
+     * Layout counts of one component.
+     */
+    struct Counts {
+        int variables = 0;
+        std::vector<double> layouts;     // [k]: layouts with k mines
+        std::vector<double> mines;       // [v * (variables + 1) + k]: those in which variable v is a mine
+        long states = 0;                 // Layer states visited
+        bool exact = true;               // False if the state limit was hit
+    };
+
+    std::unordered_map<std::string, std::shared_ptr<const Counts>> cache;  // Keyed by component equations
+    std::vector<std::string> keys;                                          // Scratch: key of each component
+    std::vector<std::shared_ptr<const Counts>> counts;                      // Scratch: counts of each component
+
+    static std::string key(const EquationSystem& equations);
+    static void count(const EquationSystem& equations, Counts& counts);
+    static std::vector<int> order(const EquationSystem& equations);
+};
+
+#endif // MINE_PROBABILITY_HPP
@@ -0,0 +1,98 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * Bounded lock-free multi-producer multi-consumer queue (Vyukov's design).
+ *
+ * Every slot carries a sequence number telling producers and consumers whose
+ * turn it is, so a push or pop is one compare-and-swap on the shared position
+ * plus one release store on the slot. Neither call blocks: they report a full
+ * or empty queue and the caller decides whether to retry.
+ */
+template <typename T>
+class MPMCQueue {
+public:
+    /**
+     * @param capacity Number of slots, rounded up to a power of two (at least 2)
+     */
+    explicit MPMCQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size *= 2;
+        mask = size - 1;
+        slots.reset(new Slot[size]);
+        for (size_t i = 0; i < size; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    /**
+     * Append a value.
+     * @param value Value to copy in
+     * @return False if the queue is full
+     */
+    bool tryPush(const T& value) {
+        size_t position = enqueue_position.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[position & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            long difference = static_cast<long>(sequence) - static_cast<long>(position);
+            if (difference == 0) {
+                if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Remove the oldest value.
+     * @param value Output for the removed value
+     * @return False if the queue is empty
+     */
+    bool tryPop(T& value) {
+        size_t position = dequeue_position.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[position & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            long difference = static_cast<long>(sequence) - static_cast<long>(position + 1);
+            if (difference == 0) {
+                if (dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = slot.value;
+                    slot.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    // Producers and consumers update different positions; keep them on separate cache lines
+    alignas(64) std::atomic<size_t> enqueue_position{0};
+    alignas(64) std::atomic<size_t> dequeue_position{0};
+};
+
+#endif // MPMC_QUEUE_HPP
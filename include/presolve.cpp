@@ -0,0 +1,232 @@
+#include "presolve.hpp"
+#include <algorithm>
+
+Presolve::Stats Presolve::run(const EquationSystem& equations, EquationSystem& reduced,
+                              std::vector<RREFProcessor::Deduction>& deductions) {
+    Stats stats;
+    reduced.clear(equations.variableCount());
+    dropped_rows.clear();
+    if (!load(equations)) {
+        for (int i = 0; i < equations.equationCount(); ++i) {
+            reduced.addEquation(equations.equation(i));
+        }
+        return stats;
+    }
+
+    bool changed = true;
+    while (changed) {
+        settleRows(stats, deductions);
+        changed = removeDuplicates(stats);
+        changed = subtractSubsets(stats) || changed;
+    }
+    dropSingletonRows(stats);
+
+    // Survivors keep their original order and stay sorted
+    for (size_t i = 0; i < row_count; ++i) {
+        const Row& row = rows[i];
+        if (!row.alive) continue;
+        for (int variable : row.variables) {
+            reduced.addTerm(variable, 1);
+        }
+        reduced.finishEquation(row.rhs);
+    }
+    return stats;
+}
+
+bool Presolve::load(const EquationSystem& equations) {
+    const int variableCount = equations.variableCount();
+    row_count = equations.equationCount();
+    if (rows.size() < row_count) rows.resize(row_count);
+    value.assign(variableCount, -1);
+
+    for (size_t i = 0; i < row_count; ++i) {
+        EquationSystem::Row equation = equations.equation(static_cast<int>(i));
+        Row& row = rows[i];
+        row.variables.assign(equation.columns, equation.columns + equation.size);
+        row.rhs = equation.rhs;
+        row.alive = true;
+        for (int k = 0; k < equation.size; ++k) {
+            if (equation.coefficients[k] != 1) return false;
+        }
+    }
+    return true;
+}
+
+void Presolve::settleRows(Stats& stats, std::vector<RREFProcessor::Deduction>& deductions) {
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (size_t i = 0; i < row_count; ++i) {
+            Row& row = rows[i];
+            if (!row.alive) continue;
+
+            // Substitute variables fixed so far
+            auto known = [&](int variable) { return value[variable] >= 0; };
+            for (int variable : row.variables) {
+                if (known(variable)) row.rhs -= value[variable];
+            }
+            row.variables.erase(std::remove_if(row.variables.begin(), row.variables.end(), known),
+                                row.variables.end());
+
+            const int size = static_cast<int>(row.variables.size());
+            if (size == 0) {
+                row.alive = false;
+                ++stats.satisfied_rows;
+                continue;
+            }
+            if (row.rhs != 0 && row.rhs != size) continue;
+
+            // Every variable is at its lower (rhs 0) or upper (rhs == size) bound
+            const bool is_mine = row.rhs == size;
+            for (int variable : row.variables) {
+                value[variable] = is_mine ? 1 : 0;
+                deductions.push_back({variable, is_mine});
+            }
+            stats.fixed_variables += size;
+            row.alive = false;
+            progress = true;
+        }
+    }
+}
+
+bool Presolve::removeDuplicates(Stats& stats) {
+    order.clear();
+    for (size_t i = 0; i < row_count; ++i) {
+        if (rows[i].alive) order.push_back(static_cast<int>(i));
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        if (rows[a].variables != rows[b].variables) return rows[a].variables < rows[b].variables;
+        return a < b;
+    });
+
+    // Keep the first of each run of rows with the same support
+    bool removed = false;
+    for (size_t k = 1; k < order.size(); ++k) {
+        Row& row = rows[order[k]];
+        if (row.variables == rows[order[k - 1]].variables) {
+            row.alive = false;
+            ++stats.duplicate_rows;
+            removed = true;
+        }
+    }
+    return removed;
+}
+
+bool Presolve::subtractSubsets(Stats& stats) {
+    const size_t variableCount = value.size();
+    if (occurrences.size() < variableCount) occurrences.resize(variableCount);
+    for (size_t v = 0; v < variableCount; ++v) {
+        occurrences[v].clear();
+    }
+
+    order.clear();
+    for (size_t i = 0; i < row_count; ++i) {
+        if (!rows[i].alive) continue;
+        order.push_back(static_cast<int>(i));
+        for (int variable : rows[i].variables) {
+            occurrences[variable].push_back(static_cast<int>(i));
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return rows[a].variables.size() < rows[b].variables.size();
+    });
+
+    bool subtracted = false;
+    for (int a : order) {
+        const Row& subset = rows[a];
+        if (!subset.alive) continue;
+
+        // Any superset contains the subset's rarest variable
+        int rarest = subset.variables[0];
+        for (int variable : subset.variables) {
+            if (occurrences[variable].size() < occurrences[rarest].size()) rarest = variable;
+        }
+
+        for (int b : occurrences[rarest]) {
+            Row& superset = rows[b];
+            if (b == a || !superset.alive || superset.variables.size() <= subset.variables.size()) continue;
+            if (!std::includes(superset.variables.begin(), superset.variables.end(),
+                               subset.variables.begin(), subset.variables.end())) continue;
+
+            difference.clear();
+            std::set_difference(superset.variables.begin(), superset.variables.end(),
+                                subset.variables.begin(), subset.variables.end(),
+                                std::back_inserter(difference));
+            superset.variables.swap(difference);
+            superset.rhs -= subset.rhs;
+            ++stats.subset_subtractions;
+            subtracted = true;
+        }
+    }
+    return subtracted;
+}
+
+void Presolve::dropSingletonRows(Stats& stats) {
+    occurrence_count.assign(value.size(), 0);
+    for (size_t i = 0; i < row_count; ++i) {
+        if (!rows[i].alive) continue;
+        for (int variable : rows[i].variables) {
+            ++occurrence_count[variable];
+        }
+    }
+
+    // A row with singletons S and other variables T leaves sum(T) free in [0, |T|];
+    // the singletons can always make up the difference when |T| <= rhs <= |S|
+    bool dropped = true;
+    while (dropped) {
+        dropped = false;
+        for (size_t i = 0; i < row_count; ++i) {
+            Row& row = rows[i];
+            if (!row.alive) continue;
+
+            int singletons = 0;
+            for (int variable : row.variables) {
+                if (occurrence_count[variable] == 1) ++singletons;
+            }
+            const int others = static_cast<int>(row.variables.size()) - singletons;
+            if (singletons == 0 || row.rhs < others || row.rhs > singletons) continue;
+
+            row.alive = false;
+            dropped_rows.push_back(static_cast<int>(i));
+            for (int variable : row.variables) {
+                --occurrence_count[variable];
+            }
+            ++stats.singleton_rows;
+            dropped = true;
+        }
+    }
+}
+
+int Presolve::recover(std::vector<RREFProcessor::Deduction>& deductions) {
+    const size_t found = deductions.size();
+    for (size_t d = 0; d < found; ++d) {
+        value[deductions[d].variable] = deductions[d].is_mine ? 1 : 0;
+    }
+
+    // Once the rest of a dropped row is known, its singletons settle as in settleRows().
+    // Rows go in reverse drop order, and a row's singletons can settle another row.
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (auto it = dropped_rows.rbegin(); it != dropped_rows.rend(); ++it) {
+            Row& row = rows[*it];
+            auto known = [&](int variable) { return value[variable] >= 0; };
+            for (int variable : row.variables) {
+                if (known(variable)) row.rhs -= value[variable];
+            }
+            row.variables.erase(std::remove_if(row.variables.begin(), row.variables.end(), known),
+                                row.variables.end());
+
+            const int size = static_cast<int>(row.variables.size());
+            if (size == 0 || (row.rhs != 0 && row.rhs != size)) continue;
+            const bool is_mine = row.rhs == size;
+            for (int variable : row.variables) {
+                value[variable] = is_mine ? 1 : 0;
+                deductions.push_back({variable, is_mine});
+            }
+            row.variables.clear();
+            progress = true;
+        }
+    }
+    return static_cast<int>(deductions.size() - found);
+}
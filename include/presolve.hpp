@@ -0,0 +1,82 @@
+#ifndef PRESOLVE_HPP
+#define PRESOLVE_HPP
+
+#include <vector>
+#include "equation_system.hpp"
+#include "rref_processor.hpp"
+
+/**
+ * Cheap reductions applied to the frontier equations before row reduction.
+ *
+ * Works on unit rows (every coefficient 1), which is what the equation
+ * builders produce, and repeats until nothing changes:
+ *  - rows with rhs 0 or rhs equal to their size fix all their variables;
+ *    fixed variables are substituted out and rows left empty are dropped
+ *  - duplicate rows are dropped
+ *  - a row whose support is a subset of another's is subtracted from it
+ *    (the 1-2-1 pattern becomes two single-cell rows)
+ * and finally drops rows whose column singletons (variables in no other row)
+ * can absorb any value of the rest of the row, which loses no solutions.
+ * recover() decides those singletons once the rest of their rows is known.
+ *
+ * Buffers are kept between calls, so an object should be reused.
+ */
+class Presolve {
+public:
+    /**
+     * What one run did.
+     */
+    struct Stats {
+        int fixed_variables = 0;      // Variables decided by rows with rhs 0 or rhs == size
+        int satisfied_rows = 0;       // Rows left without unknowns
+        int duplicate_rows = 0;       // Rows identical to an earlier one
+        int subset_subtractions = 0;  // Rows reduced by a row whose support they contain
+        int singleton_rows = 0;       // Rows dropped together with their column singletons
+    };
+
+    /**
+     * Reduce an equation system.
+     * A system with any coefficient other than 1 is copied through unchanged.
+     * @param equations The frontier equations
+     * @param reduced Output: the remaining rows over the same variable indices; storage is reused
+     * @param deductions Output list the fixed variables are appended to
+     * @return Counts of the reductions applied
+     */
+    Stats run(const EquationSystem& equations, EquationSystem& reduced,
+              std::vector<RREFProcessor::Deduction>& deductions);
+
+    /**
+     * Settle the column singletons of the rows the last run() dropped, given what
+     * is now known about the other variables (typically from row-reducing the
+     * rows run() kept). A dropped row loses no solutions, but its singletons are
+     * decided only once the rest of the row is.
+     * @param deductions The deductions so far, over the same variable indices;
+     *                   the singletons this settles are appended
+     * @return Number of deductions appended
+     */
+    int recover(std::vector<RREFProcessor::Deduction>& deductions);
+
+private:
+    struct Row {
+        std::vector<int> variables;  // Ascending variable indices
+        int rhs = 0;
+        bool alive = false;
+    };
+
+    std::vector<Row> rows;                      // First row_count entries are in use
+    size_t row_count = 0;
+    std::vector<signed char> value;             // Per variable: -1 unknown, else 0 or 1
+    std::vector<std::vector<int>> occurrences;  // Per variable: rows that contained it
+    std::vector<int> occurrence_count;          // Per variable: live rows containing it
+    std::vector<int> dropped_rows;              // Rows dropped with their singletons, in order
+    std::vector<int> order;                     // Scratch row ordering
+    std::vector<int> difference;                // Scratch for subset subtraction
+
+    bool load(const EquationSystem& equations);
+    void settleRows(Stats& stats, std::vector<RREFProcessor::Deduction>& deductions);
+    bool removeDuplicates(Stats& stats);
+    bool subtractSubsets(Stats& stats);
+    void dropSingletonRows(Stats& stats);
+};
+
+#endif // PRESOLVE_HPP
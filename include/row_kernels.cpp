@@ -0,0 +1,178 @@
+#include "row_kernels.hpp"
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+// GCC 12 fills the unused lanes of some AVX-512 intrinsics from a deliberately
+// uninitialised vector, and -Wall then warns inside its own header
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#define ROW_KERNELS_X86 1
+#endif
+
+namespace {
+
+using MulSubFunction = void (*)(int64_t*, const int64_t*, int64_t, int64_t, size_t, size_t);
+using MaxAbsFunction = int64_t (*)(const int64_t*, size_t);
+
+void mulSubScalar(int64_t* row, const int64_t* pivot, int64_t p, int64_t a, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        row[i] = p * row[i] - a * pivot[i];
+    }
+}
+
+int64_t maxAbsScalar(const int64_t* row, size_t count) {
+    int64_t result = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int64_t value = std::llabs(row[i]);
+        if (value > result) result = value;
+    }
+    return result;
+}
+
+#ifdef ROW_KERNELS_X86
+
+__attribute__((target("avx2")))
+void mulSubAVX2(int64_t* row, const int64_t* pivot, int64_t p, int64_t a, size_t begin, size_t end) {
+    const __m256i pv = _mm256_set1_epi64x(p);
+    const __m256i av = _mm256_set1_epi64x(a);
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pivot + i));
+        // Signed 32x32->64 multiplies; exact because all operands fit in 32 bits
+        __m256i result = _mm256_sub_epi64(_mm256_mul_epi32(x, pv), _mm256_mul_epi32(y, av));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + i), result);
+    }
+    mulSubScalar(row, pivot, p, a, i, end);
+}
+
+__attribute__((target("avx2")))
+int64_t maxAbsAVX2(const int64_t* row, size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i best = zero;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+        __m256i sign = _mm256_cmpgt_epi64(zero, x);
+        __m256i magnitude = _mm256_sub_epi64(_mm256_xor_si256(x, sign), sign);
+        best = _mm256_blendv_epi8(best, magnitude, _mm256_cmpgt_epi64(magnitude, best));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+    int64_t result = maxAbsScalar(row + i, count - i);
+    for (int64_t lane : lanes) {
+        if (lane > result) result = lane;
+    }
+    return result;
+}
+
+__attribute__((target("avx512f")))
+void mulSubAVX512(int64_t* row, const int64_t* pivot, int64_t p, int64_t a, size_t begin, size_t end) {
+    const __m512i pv = _mm512_set1_epi64(p);
+    const __m512i av = _mm512_set1_epi64(a);
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m512i x = _mm512_loadu_si512(row + i);
+        __m512i y = _mm512_loadu_si512(pivot + i);
+        __m512i result = _mm512_sub_epi64(_mm512_mul_epi32(x, pv), _mm512_mul_epi32(y, av));
+        _mm512_storeu_si512(row + i, result);
+    }
+    if (i < end) {
+        // Masked tail instead of a scalar loop
+        __mmask8 mask = static_cast<__mmask8>((1u << (end - i)) - 1);
+        __m512i x = _mm512_maskz_loadu_epi64(mask, row + i);
+        __m512i y = _mm512_maskz_loadu_epi64(mask, pivot + i);
+        __m512i result = _mm512_sub_epi64(_mm512_mul_epi32(x, pv), _mm512_mul_epi32(y, av));
+        _mm512_mask_storeu_epi64(row + i, mask, result);
+    }
+}
+
+__attribute__((target("avx512f")))
+int64_t maxAbsAVX512(const int64_t* row, size_t count) {
+    __m512i best = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        best = _mm512_max_epi64(best, _mm512_abs_epi64(_mm512_loadu_si512(row + i)));
+    }
+    if (i < count) {
+        __mmask8 mask = static_cast<__mmask8>((1u << (count - i)) - 1);
+        best = _mm512_max_epi64(best, _mm512_abs_epi64(_mm512_maskz_loadu_epi64(mask, row + i)));
+    }
+    return _mm512_reduce_max_epi64(best);
+}
+
+#endif // ROW_KERNELS_X86
+
+struct Dispatch {
+    RowKernels::Isa isa;
+    MulSubFunction mulSub;
+    MaxAbsFunction maxAbs;
+};
+
+bool supported(RowKernels::Isa isa) {
+#ifdef ROW_KERNELS_X86
+    switch (isa) {
+        case RowKernels::Isa::AVX512: return __builtin_cpu_supports("avx512f");
+        case RowKernels::Isa::AVX2: return __builtin_cpu_supports("avx2");
+        case RowKernels::Isa::Scalar: return true;
+    }
+    return false;
+#else
+    return isa == RowKernels::Isa::Scalar;
+#endif
+}
+
+Dispatch makeDispatch(RowKernels::Isa isa) {
+#ifdef ROW_KERNELS_X86
+    if (isa == RowKernels::Isa::AVX512) return {isa, mulSubAVX512, maxAbsAVX512};
+    if (isa == RowKernels::Isa::AVX2) return {isa, mulSubAVX2, maxAbsAVX2};
+#endif
+    return {RowKernels::Isa::Scalar, mulSubScalar, maxAbsScalar};
+}
+
+Dispatch& dispatch() {
+    static Dispatch current = makeDispatch(RowKernels::detect());
+    return current;
+}
+
+} // namespace
+
+void RowKernels::mulSub(int64_t* row, const int64_t* pivot, int64_t p, int64_t a, size_t begin, size_t end) {
+    dispatch().mulSub(row, pivot, p, a, begin, end);
+}
+
+int64_t RowKernels::maxAbs(const int64_t* row, size_t count) {
+    return dispatch().maxAbs(row, count);
+}
+
+RowKernels::Isa RowKernels::active() {
+    return dispatch().isa;
+}
+
+RowKernels::Isa RowKernels::detect() {
+    if (supported(Isa::AVX512)) return Isa::AVX512;
+    if (supported(Isa::AVX2)) return Isa::AVX2;
+    return Isa::Scalar;
+}
+
+bool RowKernels::select(Isa isa) {
+    if (!supported(isa)) return false;
+    dispatch() = makeDispatch(isa);
+    return true;
+}
+
+const char* RowKernels::name(Isa isa) {
+    switch (isa) {
+        case Isa::AVX512: return "avx512";
+        case Isa::AVX2: return "avx2";
+        case Isa::Scalar: return "scalar";
+    }
+    return "unknown";
+}
@@ -0,0 +1,83 @@
+#ifndef ROW_KERNELS_HPP
+#define ROW_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Vectorised row operations for the 64-bit integer elimination engine.
+ *
+ * The fast kernels rely on every operand fitting in 32 bits: products then fit
+ * in 62 bits and their difference cannot overflow, so no per-element overflow
+ * check is needed. Callers check SMALL_ENTRY_LIMIT before using them and fall
+ * back to checked scalar arithmetic otherwise.
+ *
+ * The instruction set is chosen once at startup from what the CPU supports
+ * (AVX-512F, then AVX2, then scalar) and can be overridden with select().
+ */
+class RowKernels {
+public:
+    /**
+     * Instruction sets with a kernel implementation.
+     */
+    enum class Isa {
+        Scalar,
+        AVX2,
+        AVX512
+    };
+
+    // Exclusive bound on |entry| and |multiplier| for the unchecked kernels
+    static constexpr int64_t SMALL_ENTRY_LIMIT = int64_t(1) << 31;
+
+    // Rows are padded to a multiple of this many entries (one 64-byte line)
+    static constexpr size_t ROW_ALIGNMENT = 8;
+
+    /**
+     * Compute row[i] = p * row[i] - a * pivot[i] for i in [begin, end).
+     * Requires |p|, |a| and all affected entries to be below SMALL_ENTRY_LIMIT.
+     * @param row The row being updated
+     * @param pivot The pivot row
+     * @param p Multiplier of row
+     * @param a Multiplier of pivot
+     * @param begin First column to update
+     * @param end One past the last column to update
+     */
+    static void mulSub(int64_t* row, const int64_t* pivot, int64_t p, int64_t a, size_t begin, size_t end);
+
+    /**
+     * Compute the largest absolute value in a row.
+     * Entries must not be INT64_MIN.
+     * @param row The row to scan
+     * @param count Number of entries
+     * @return max |row[i]|, or 0 for an empty row
+     */
+    static int64_t maxAbs(const int64_t* row, size_t count);
+
+    /**
+     * Get the instruction set currently used.
+     * @return The active instruction set
+     */
+    static Isa active();
+
+    /**
+     * Get the best instruction set supported by this CPU.
+     * @return The detected instruction set
+     */
+    static Isa detect();
+
+    /**
+     * Force an instruction set, e.g. for benchmarking.
+     * @param isa The instruction set to use
+     * @return False (and no change) if the CPU does not support it
+     */
+    static bool select(Isa isa);
+
+    /**
+     * Get a printable name for an instruction set.
+     * @param isa The instruction set
+     * @return "scalar", "avx2" or "avx512"
+     */
+    static const char* name(Isa isa);
+};
+
+#endif // ROW_KERNELS_HPP
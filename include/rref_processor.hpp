@@ -2,80 +2,53 @@
 #define RREF_PROCESSOR_HPP
 
 #include <vector>
-#include "two_way_dict.hpp"
+#include "equation_system.hpp"
 #include "solver_constants.hpp"
 
-// Forward declarations
-class MSBoard;
-
 /**
  * Helper class for processing Row-Reduced Echelon Form (RREF) matrices
  * to determine mine locations and safe cells in Minesweeper.
+ * It only reads equations; applying the deductions is up to the caller.
  */
 class RREFProcessor {
 public:
     /**
-     * Process RREF matrix to determine mine locations and safe cells.
-     * @param rrefVector The RREF matrix as a vector of vectors
-     * @param unrevealed_indices Mapping of unrevealed squares to equation indices
-     * @param board Reference to the Minesweeper board
-     * @param cols Number of columns in the board
+     * A single certain conclusion about a variable.
+     */
+    struct Deduction {
+        int variable;  // Variable (equation column) index
+        bool is_mine;  // True if the variable must be a mine, false if it must be safe
+    };
+
+    /**
+     * Determine mine locations and safe cells without touching the board.
+     * @param rref The reduced equation system
+     * @param deductions Output list the deductions are appended to
      */
-    static void processRREF(const std::vector<std::vector<int>>& rrefVector,
-                           const TwoWayDict& unrevealed_indices,
-                           MSBoard& board,
-                           int cols);
+    static void collectDeductions(const EquationSystem& rref, std::vector<Deduction>& deductions);
 
 private:
     /**
      * Process a single equation row to determine mine locations and safe cells.
-     * @param equation The equation row (coefficients + RHS)
-     * @param unrevealed_indices Mapping of unrevealed squares to equation indices
-     * @param board Reference to the Minesweeper board
-     * @param cols Number of columns in the board
+     * @param equation The sparse equation row
+     * @param deductions Output list the deductions are appended to
      */
-    static void processEquation(const std::vector<int>& equation,
-                               const TwoWayDict& unrevealed_indices,
-                               MSBoard& board,
-                               int cols);
+    static void processEquation(const EquationSystem::Row& equation,
+                               std::vector<Deduction>& deductions);
 
     /**
      * Calculate the minimum possible value for the equation.
-     * @param equation The equation coefficients (excluding RHS)
+     * @param equation The sparse equation row
      * @return The minimum possible value
      */
-    static int calculateMinValue(const std::vector<int>& equation);
+    static int calculateMinValue(const EquationSystem::Row& equation);
 
     /**
      * Calculate the maximum possible value for the equation.
-     * @param equation The equation coefficients (excluding RHS)
+     * @param equation The sparse equation row
      * @return The maximum possible value
      */
-    static int calculateMaxValue(const std::vector<int>& equation);
-
-    /**
-     * Convert a 1D index to 2D board coordinates.
-     * @param index The 1D index
-     * @param cols Number of columns in the board
-     * @return Pair of (row, col) coordinates
-     */
-    static std::pair<int, int> indexToCoordinates(int index, int cols);
-
-    /**
-     * Mark a cell as a mine on the board.
-     * @param board Reference to the Minesweeper board
-     * @param r Row index
-     * @param c Column index
-     */
-    static void markMine(MSBoard& board, int r, int c);
-
-    /**
-     * Open a cell on the board.
-     * @param board Reference to the Minesweeper board
-     * @param r Row index
-     * @param c Column index
-     */
-    static void openCell(MSBoard& board, int r, int c);
+    static int calculateMaxValue(const EquationSystem::Row& equation);
 };
 
 #endif // RREF_PROCESSOR_HPP
@@ -1,14 +1,17 @@
 #ifndef SOLVER_CONSTANTS_HPP
 #define SOLVER_CONSTANTS_HPP
 
+#include <array>
+#include <cstddef>
+
 namespace SolverConstants {
     // Board state values
     constexpr int UNREVEALED = -1;
     constexpr int MARKED_MINE = -2;
     
-    // RREF processing constants
-    constexpr int RREF_SKIP_FREQUENCY = 3;  // Skip RREF every 3rd iteration
-    constexpr int RREF_SKIP_CONDITION = 2;  // When (x % 3 == 2)
+    // Elimination scheduling: weight of the newest observation in the
+    // AdaptiveScheduler's moving averages
+    constexpr double SCHEDULER_SMOOTHING = 0.2;
     
     // Neighbor search directions (8-connected)
     constexpr int NEIGHBOR_DIRECTIONS[8][2] = {
@@ -16,9 +19,35 @@ namespace SolverConstants {
         { 0, -1},           { 0, 1},
         { 1, -1}, { 1, 0}, { 1, 1}
     };
+
+    /**
+     * Index offsets of the eight neighbors in a row-major grid, in NEIGHBOR_DIRECTIONS order.
+     * @param stride Distance between vertically adjacent cells
+     * @return Offset to add to a cell index for each direction
+     */
+    constexpr std::array<int, 8> neighborOffsets(int stride) {
+        std::array<int, 8> offsets{};
+        for (int k = 0; k < 8; ++k) {
+            offsets[k] = NEIGHBOR_DIRECTIONS[k][0] * stride + NEIGHBOR_DIRECTIONS[k][1];
+        }
+        return offsets;
+    }
+    static_assert(neighborOffsets(10)[0] == -11 && neighborOffsets(10)[7] == 11,
+                  "neighbor offsets must follow NEIGHBOR_DIRECTIONS");
     
     // Matrix operation constants
     constexpr double MATRIX_TOLERANCE = 1e-10;
+    
+    // Minimum estimated elimination work (rows * cols * rank summed over components)
+    // before components are solved on the thread pool
+    constexpr unsigned long PARALLEL_MIN_ELIMINATION_COST = 1UL << 16;
+
+    // Exact mine probabilities: layer states a component may need before it is
+    // given up as too wide, components kept in the count cache, and variables to
+    // count before uncached components are counted on the thread pool
+    constexpr long PROBABILITY_MAX_STATES = 1L << 20;
+    constexpr size_t PROBABILITY_CACHE_LIMIT = 1 << 12;
+    constexpr size_t PROBABILITY_PARALLEL_MIN_VARIABLES = 64;
 }
 
 #endif // SOLVER_CONSTANTS_HPP
@@ -1,54 +1,94 @@
 #include "two_way_dict.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+TwoWayDict::TwoWayDict(int keyCount) {
+    reset(keyCount);
+}
+
+void TwoWayDict::reset(int keyCount) {
+    if (static_cast<int>(forward.size()) < keyCount) {
+        forward.resize(keyCount);
+    }
+    clear();
+}
+
+void TwoWayDict::clear() {
+    count = 0;
+    if (++generation == 0) {
+        // The stamp wrapped around: old slots could look live again, so wipe them once
+        for (auto& slot : forward) slot.stamp = 0;
+        for (auto& slot : reverse) slot.stamp = 0;
+        generation = 1;
+    }
+}
+
+bool TwoWayDict::live(const std::vector<Slot>& slots, int index) const {
+    return index >= 0 && index < static_cast<int>(slots.size()) && slots[index].stamp == generation;
+}
 
 void TwoWayDict::insert(int key, int value) {
-    // Remove existing mapping for the key if it exists
-    if (forward_map.find(key) != forward_map.end()) {
-        int old_value = forward_map[key];
-        forward_map.erase(key);
-        reverse_map.erase(old_value);
-    }
-    
-    // Remove existing mapping for the value if it exists
-    if (reverse_map.find(value) != reverse_map.end()) {
-        int old_key = reverse_map[value];
-        reverse_map.erase(value);
-        forward_map.erase(old_key);
-    }
-    
+    if (key < 0 || value < 0) {
+        throw std::out_of_range("TwoWayDict keys and values must be non-negative");
+    }
+
+    // Remove existing mappings for the key and for the value
+    erase(key);
+    if (live(reverse, value)) {
+        erase(reverse[value].other);
+    }
+
+    if (key >= static_cast<int>(forward.size())) forward.resize(key + 1);
+    if (value >= static_cast<int>(reverse.size())) reverse.resize(value + 1);
+
     // Insert the new mapping
-    forward_map[key] = value;
-    reverse_map[value] = key;
+    forward[key] = {value, generation};
+    reverse[value] = {key, generation};
+    ++count;
 }
 
 void TwoWayDict::erase(int key) {
-    if (forward_map.find(key) != forward_map.end()) {
-        int value = forward_map[key];
-        forward_map.erase(key);
-        reverse_map.erase(value);
+    if (live(forward, key)) {
+        reverse[forward[key].other].stamp = 0;
+        forward[key].stamp = 0;
+        --count;
     }
 }
 
 int TwoWayDict::size() const {
-    return forward_map.size();
+    return count;
 }
 
 bool TwoWayDict::contains_key(int key) const {
-    return forward_map.find(key) != forward_map.end();
+    return live(forward, key);
 }
 
 int TwoWayDict::get_value(int key) const {
-    return forward_map.at(key);
+    if (!live(forward, key)) {
+        throw std::out_of_range("TwoWayDict key not found");
+    }
+    return forward[key].other;
+}
+
+int TwoWayDict::find_value(int key) const {
+    return live(forward, key) ? forward[key].other : -1;
 }
 
 int TwoWayDict::get_key(int value) const {
-    return reverse_map.at(value);
+    if (!live(reverse, value)) {
+        throw std::out_of_range("TwoWayDict value not found");
+    }
+    return reverse[value].other;
 }
 
 std::vector<int> TwoWayDict::get_keys() const {
     std::vector<int> keys;
-    keys.reserve(forward_map.size());
-    for (const auto& pair : forward_map) {
-        keys.push_back(pair.first);
+    keys.reserve(count);
+    for (const auto& slot : reverse) {
+        if (slot.stamp == generation) {
+            keys.push_back(slot.other);
+        }
     }
+    std::sort(keys.begin(), keys.end());
     return keys;
 }
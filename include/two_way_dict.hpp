@@ -1,23 +1,54 @@
 #ifndef TWO_WAY_DICT_HPP
 #define TWO_WAY_DICT_HPP
 
-#include <map>
 #include <vector>
 
 /**
  * A bidirectional dictionary that maintains mappings in both directions.
  * This allows efficient lookup by key or by value.
+ *
+ * Keys and values are small non-negative integers (board cell indices and
+ * variable indices), so both directions are dense arrays indexed directly,
+ * giving O(1) lookups. Each slot carries the generation in which it was
+ * written; clear() starts a new generation instead of touching the arrays.
  */
 class TwoWayDict {
 private:
-    std::map<int, int> forward_map;
-    std::map<int, int> reverse_map;
+    struct Slot {
+        int other = 0;          // The mapped key or value
+        unsigned stamp = 0;     // Slot is live when this equals generation
+    };
+
+    std::vector<Slot> forward;  // key -> value
+    std::vector<Slot> reverse;  // value -> key
+    unsigned generation = 1;
+    int count = 0;
+
+    bool live(const std::vector<Slot>& slots, int index) const;
 
 public:
+    /**
+     * Create an empty dictionary with room for keys below keyCount.
+     * @param keyCount Expected key bound; larger keys still work but grow the table
+     */
+    explicit TwoWayDict(int keyCount = 0);
+
+    /**
+     * Remove every mapping and make room for keys below keyCount, reusing storage.
+     * @param keyCount Expected key bound
+     */
+    void reset(int keyCount);
+
+    /**
+     * Remove every mapping in O(1).
+     */
+    void clear();
+
     /**
      * Insert a key-value pair, removing any existing mappings for either key or value.
-     * @param key The key to insert
-     * @param value The value to associate with the key
+     * @param key The key to insert (non-negative)
+     * @param value The value to associate with the key (non-negative)
+     * @throws std::out_of_range if key or value is negative
      */
     void insert(int key, int value);
 
@@ -48,6 +79,13 @@ public:
      */
     int get_value(int key) const;
 
+    /**
+     * Get the value associated with a key, if any, in a single lookup.
+     * @param key The key to look up
+     * @return The associated value, or -1 if the key doesn't exist
+     */
+    int find_value(int key) const;
+
     /**
      * Get the key associated with a value.
      * @param value The value to look up
@@ -58,7 +96,7 @@ public:
 
     /**
      * Get all keys in the dictionary.
-     * @return A vector containing all keys
+     * @return A vector containing all keys, in ascending order
      */
     std::vector<int> get_keys() const;
 };
@@ -0,0 +1,32 @@
+#include "union_find.hpp"
+#include <utility>
+
+UnionFind::UnionFind(int count) {
+    reset(count);
+}
+
+void UnionFind::reset(int count) {
+    parent.resize(count);
+    set_size.assign(count, 1);
+    for (int i = 0; i < count; ++i) {
+        parent[i] = i;
+    }
+}
+
+int UnionFind::find(int element) {
+    while (parent[element] != element) {
+        parent[element] = parent[parent[element]];
+        element = parent[element];
+    }
+    return element;
+}
+
+int UnionFind::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return a;
+    if (set_size[a] < set_size[b]) std::swap(a, b);
+    parent[b] = a;
+    set_size[a] += set_size[b];
+    return a;
+}
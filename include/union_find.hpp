@@ -0,0 +1,43 @@
+#ifndef UNION_FIND_HPP
+#define UNION_FIND_HPP
+
+#include <vector>
+
+/**
+ * Disjoint-set forest with union by size and path halving.
+ */
+class UnionFind {
+private:
+    std::vector<int> parent;
+    std::vector<int> set_size;
+
+public:
+    /**
+     * Create a forest of singleton sets.
+     * @param count Number of elements
+     */
+    explicit UnionFind(int count = 0);
+
+    /**
+     * Reset to count singleton sets, reusing storage.
+     * @param count Number of elements
+     */
+    void reset(int count);
+
+    /**
+     * Find the representative of an element's set.
+     * @param element The element to look up
+     * @return The representative element
+     */
+    int find(int element);
+
+    /**
+     * Merge the sets containing two elements.
+     * @param a First element
+     * @param b Second element
+     * @return The representative of the merged set
+     */
+    int unite(int a, int b);
+};
+
+#endif // UNION_FIND_HPP
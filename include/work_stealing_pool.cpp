@@ -0,0 +1,142 @@
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <numeric>
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (unsigned i = 1; i < threadCount; ++i) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+unsigned WorkStealingPool::threadCount() const {
+    return static_cast<unsigned>(queues.size());
+}
+
+void WorkStealingPool::run(const std::vector<size_t>& costs, const std::function<void(size_t)>& task) {
+    if (costs.empty()) return;
+
+    // One batch at a time: a second caller, or a task calling back into the
+    // pool, runs its batch inline instead of waiting for the workers
+    bool idle = false;
+    if (threads.empty() || costs.size() == 1 ||
+        !running.compare_exchange_strong(idle, true, std::memory_order_acquire)) {
+        for (size_t i = 0; i < costs.size(); ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    // Deal tasks round-robin in descending cost order so every worker starts on a large one
+    std::vector<size_t> order(costs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&costs](size_t a, size_t b) { return costs[a] > costs[b]; });
+    for (size_t i = 0; i < order.size(); ++i) {
+        WorkerQueue& queue = *queues[i % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(order[i]);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        current_task = &task;
+        first_error = nullptr;
+        remaining = costs.size();
+        ++generation;
+    }
+    work_ready.notify_all();
+
+    drain(0, task);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        work_done.wait(lock, [this] { return remaining == 0 && busy_workers == 0; });
+        current_task = nullptr;
+        error = first_error;
+    }
+    running.store(false, std::memory_order_release);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkStealingPool::workerLoop(unsigned index) {
+    size_t seen_generation = 0;
+    while (true) {
+        const std::function<void(size_t)>* task;
+        {
+            std::unique_lock<std::mutex> lock(state_mutex);
+            work_ready.wait(lock, [&] { return stopping || generation != seen_generation; });
+            if (stopping) return;
+            seen_generation = generation;
+            task = current_task;
+            ++busy_workers;
+        }
+
+        if (task) {
+            drain(index, *task);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            --busy_workers;
+        }
+        work_done.notify_all();
+    }
+}
+
+void WorkStealingPool::drain(unsigned index, const std::function<void(size_t)>& task) {
+    size_t taskIndex;
+    while (popLocal(index, taskIndex) || steal(index, taskIndex)) {
+        try {
+            task(taskIndex);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            if (!first_error) first_error = std::current_exception();
+        }
+        if (--remaining == 0) {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            work_done.notify_all();
+        }
+    }
+}
+
+bool WorkStealingPool::popLocal(unsigned index, size_t& taskIndex) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    taskIndex = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned thief, size_t& taskIndex) {
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkerQueue& victim = *queues[(thief + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            taskIndex = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
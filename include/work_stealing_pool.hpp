@@ -0,0 +1,84 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size thread pool that runs batches of indexed tasks with work stealing.
+ *
+ * Tasks are dealt to per-worker deques in descending order of cost. Each worker
+ * takes work from the front of its own deque (largest first) and, once empty,
+ * steals from the back of the others (smallest first). The calling thread acts
+ * as worker 0, so a pool of size one runs everything inline.
+ *
+ * run() may be called from any thread, including from inside a task. The
+ * workers serve one batch at a time; a batch started while another is in
+ * flight runs inline on its caller rather than queueing behind it.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * Start the worker threads.
+     * @param threadCount Total number of workers including the caller; 0 uses the hardware concurrency
+     */
+    explicit WorkStealingPool(unsigned threadCount = 0);
+
+    /**
+     * Stop and join the worker threads.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * Get the number of workers, including the calling thread.
+     * @return The worker count
+     */
+    unsigned threadCount() const;
+
+    /**
+     * Run task(i) for every i in [0, costs.size()) and wait for all of them to finish.
+     * If the workers are busy with another batch, every task runs on the calling thread.
+     * @param costs Estimated cost of each task, used to schedule large tasks first
+     * @param task The task body, called once per index from any worker
+     * @throws Rethrows the first exception thrown by a task, after the batch has finished
+     */
+    void run(const std::vector<size_t>& costs, const std::function<void(size_t)>& task);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // queues[0] belongs to the calling thread
+
+    std::mutex state_mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    const std::function<void(size_t)>* current_task = nullptr;
+    size_t generation = 0;
+    unsigned busy_workers = 0;
+    bool stopping = false;
+    std::atomic<size_t> remaining{0};
+    std::atomic<bool> running{false};  // A batch owns the workers
+    std::exception_ptr first_error;
+
+    void workerLoop(unsigned index);
+    void drain(unsigned index, const std::function<void(size_t)>& task);
+    bool popLocal(unsigned index, size_t& taskIndex);
+    bool steal(unsigned thief, size_t& taskIndex);
+};
+
+#endif // WORK_STEALING_POOL_HPP
@@ -0,0 +1,70 @@
+#ifndef XOSHIRO256_HPP
+#define XOSHIRO256_HPP
+
+#include <cstdint>
+
+/**
+ * xoshiro256** pseudo-random generator (Blackman and Vigna).
+ *
+ * Small, fast and with explicit state, so every board owns its own stream
+ * and a seed reproduces a game exactly. Seeds are expanded with splitmix64,
+ * as the authors recommend.
+ */
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(uint64_t seed = 0) { reseed(seed); }
+
+    /**
+     * Restart the stream from a seed.
+     * @param seed Any value, including 0
+     */
+    void reseed(uint64_t seed) {
+        for (auto& word : state) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * @return The next 64 random bits
+     */
+    uint64_t next() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    /**
+     * Draw uniformly from [0, bound) without modulo bias (Lemire's method).
+     * @param bound Exclusive upper bound, at least 1
+     * @return The drawn value
+     */
+    uint64_t below(uint64_t bound) {
+        unsigned __int128 product = static_cast<unsigned __int128>(next()) * bound;
+        uint64_t low = static_cast<uint64_t>(product);
+        if (low < bound) {
+            const uint64_t threshold = -bound % bound;
+            while (low < threshold) {
+                product = static_cast<unsigned __int128>(next()) * bound;
+                low = static_cast<uint64_t>(product);
+            }
+        }
+        return static_cast<uint64_t>(product >> 64);
+    }
+
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+#endif // XOSHIRO256_HPP
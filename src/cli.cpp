@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "minesweeper_class.hpp"
+#include "minesweeper_solver.hpp"
+#include "game_runner.hpp"
+
+/**
+ * Headless command line front end: plays seeded games with the solver and
+ * prints the outcome, without any graphics libraries.
+ *
+ * Usage: minesweeper_cli [--rows R] [--cols C] [--mines M] [--seed S] [--games N]
+ *                        [--threads T] [--board] [--guess]
+ * Defaults to one expert game (16x30, 99 mines). Games run concurrently on
+ * T threads (default: all cores). --board plays on the calling thread and
+ * prints the final state of every game. --guess opens the safest cell
+ * whenever no certain move is left, so games end solved or lost.
+ */
+
+namespace {
+
+struct Options {
+    int rows = 16;
+    int cols = 30;
+    int mines = 99;
+    uint64_t seed = 1;
+    int games = 1;
+    unsigned threads = 0;
+    bool print_board = false;
+    bool guess = false;
+};
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const char* value = i + 1 < argc ? argv[i + 1] : "0";
+        if (std::strcmp(argv[i], "--board") == 0) {
+            options.print_board = true;
+            continue;
+        }
+        if (std::strcmp(argv[i], "--guess") == 0) {
+            options.guess = true;
+            continue;
+        }
+        if (std::strcmp(argv[i], "--rows") == 0) options.rows = std::atoi(value);
+        else if (std::strcmp(argv[i], "--cols") == 0) options.cols = std::atoi(value);
+        else if (std::strcmp(argv[i], "--mines") == 0) options.mines = std::atoi(value);
+        else if (std::strcmp(argv[i], "--seed") == 0) options.seed = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(argv[i], "--games") == 0) options.games = std::atoi(value);
+        else if (std::strcmp(argv[i], "--threads") == 0) options.threads = std::atoi(value);
+        else {
+            std::fprintf(stderr, "Unknown option '%s'\n", argv[i]);
+            continue;
+        }
+        ++i;
+    }
+    return options;
+}
+
+void printBoard(const MSBoard& board) {
+    for (int r = 0; r < board.rows; ++r) {
+        for (int c = 0; c < board.cols; ++c) {
+            int cell = board.revealedBoard(r, c);
+            char symbol = cell == SolverConstants::UNREVEALED ? '.'
+                        : cell == SolverConstants::MARKED_MINE ? 'F'
+                        : cell == 0 ? ' ' : static_cast<char>('0' + cell);
+            std::putchar(symbol);
+        }
+        std::putchar('\n');
+    }
+}
+
+const char* outcomeName(GameRunner::Outcome outcome) {
+    switch (outcome) {
+        case GameRunner::Outcome::Won: return "solved";
+        case GameRunner::Outcome::Stuck: return "stuck";
+        case GameRunner::Outcome::Lost: return "lost";
+    }
+    return "unknown";
+}
+
+void printResult(const GameRunner::GameResult& result) {
+    std::printf("seed %llu: %s after %d steps (%d guesses), %d cells unrevealed\n",
+                static_cast<unsigned long long>(result.seed), outcomeName(result.outcome),
+                result.steps, result.guesses, result.unrevealed);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+    if (options.rows < 1 || options.cols < 1 || options.mines < 0 || options.games < 1) {
+        std::fprintf(stderr, "Invalid board size or game count\n");
+        return 1;
+    }
+
+    if (options.print_board) {
+        MSBoard board(options.rows, options.cols, options.mines, options.seed);
+        int won = 0;
+        for (int game = 0; game < options.games; ++game) {
+            GameRunner::GameResult result = GameRunner::play(board, options.seed + game, options.guess);
+            won += result.outcome == GameRunner::Outcome::Won;
+            printResult(result);
+            printBoard(board);
+        }
+        std::printf("solved %d/%d\n", won, options.games);
+        return 0;
+    }
+
+    GameRunner runner(options.threads, options.guess);
+    std::vector<GameRunner::GameResult> results;
+    GameRunner::Summary summary = runner.run(options.rows, options.cols, options.mines,
+                                             options.seed, options.games, results);
+    for (const auto& result : results) {
+        printResult(result);
+    }
+    std::printf("solved %d/%d, stuck %d, lost %d; %.1f games/s on %u threads\n", summary.won, summary.games,
+                summary.stuck, summary.lost, summary.wall_seconds > 0 ? summary.games / summary.wall_seconds : 0,
+                runner.threadCount());
+    return 0;
+}
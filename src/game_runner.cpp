@@ -0,0 +1,101 @@
+#include "game_runner.hpp"
+#include "minesweeper_class.hpp"
+#include "minesweeper_solver.hpp"
+#include "../include/mpmc_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Finished {
+    int index;
+    GameRunner::GameResult result;
+};
+
+} // namespace
+
+GameRunner::GameRunner(unsigned threadCount, bool guess) : guess_enabled(guess) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    thread_count = threadCount == 0 ? 1 : threadCount;
+}
+
+unsigned GameRunner::threadCount() const {
+    return thread_count;
+}
+
+GameRunner::Summary GameRunner::run(int rows, int cols, int mines, uint64_t firstSeed, int count,
+                                    std::vector<GameResult>& results) const {
+    Summary summary;
+    results.assign(count > 0 ? count : 0, GameResult());
+    if (count <= 0) return summary;
+
+    auto start = Clock::now();
+    std::atomic<int> next_game{0};
+    MPMCQueue<Finished> finished(4 * thread_count);
+
+    auto worker = [&] {
+        MinesweeperSolver::setSerial(true);
+        MSBoard board(rows, cols, mines, firstSeed);
+        for (int index = next_game.fetch_add(1); index < count; index = next_game.fetch_add(1)) {
+            Finished item{index, play(board, firstSeed + index, guess_enabled)};
+            while (!finished.tryPush(item)) {
+                std::this_thread::yield(); // The calling thread is behind; let it drain
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (unsigned i = 0; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+
+    // The calling thread only aggregates
+    for (int received = 0; received < count;) {
+        Finished item;
+        if (!finished.tryPop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        results[item.index] = item.result;
+        ++received;
+        ++summary.games;
+        summary.steps += item.result.steps;
+        summary.guesses += item.result.guesses;
+        switch (item.result.outcome) {
+            case Outcome::Won: ++summary.won; break;
+            case Outcome::Stuck: ++summary.stuck; break;
+            case Outcome::Lost: ++summary.lost; break;
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    summary.wall_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return summary;
+}
+
+GameRunner::GameResult GameRunner::play(MSBoard& board, uint64_t seed, bool guess) {
+    GameResult result;
+    result.seed = seed;
+    auto start = Clock::now();
+
+    board.reset(seed);
+    if (board.open(board.rows / 2, board.cols / 2) == MSBoard::OpenResult::Safe) {
+        MinesweeperSolver::Budget budget;
+        budget.guess = guess;
+        MinesweeperSolver::RunResult run = MinesweeperSolver::solveUntilStuck(board, budget);
+        result.steps = run.steps;
+        result.guesses = run.guesses;
+    }
+
+    result.unrevealed = board.unrevealedCount();
+    result.outcome = board.isLost() ? Outcome::Lost : board.isSolved() ? Outcome::Won : Outcome::Stuck;
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,97 @@
+#ifndef GAME_RUNNER_HPP
+#define GAME_RUNNER_HPP
+
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+class MSBoard;
+
+/**
+ * Plays many independent games concurrently, one game per worker at a time.
+ *
+ * Every worker owns its board (reset in place between games, so each game
+ * has its own seeded RNG stream) and solves on its own thread with the
+ * thread-local solver workspace in serial mode. Workers claim game indices
+ * from an atomic counter and hand results to the calling thread through a
+ * lock-free queue; nothing else is shared, so throughput grows with the
+ * number of cores.
+ */
+class GameRunner {
+public:
+    /**
+     * How a game ended.
+     */
+    enum class Outcome {
+        Won,    // Every safe cell was opened, marked mines or not
+        Stuck,  // The solver found no further certain move
+        Lost    // A mine was opened (only when guessing)
+    };
+
+    /**
+     * Result of one game.
+     */
+    struct GameResult {
+        uint64_t seed = 0;
+        Outcome outcome = Outcome::Stuck;
+        int steps = 0;        // Solver tier runs that made progress
+        int guesses = 0;      // Cells opened on their probability alone
+        int unrevealed = 0;   // Cells left unrevealed and unmarked
+        double seconds = 0;   // Time spent playing the game
+    };
+
+    /**
+     * Totals over a run.
+     */
+    struct Summary {
+        int games = 0;
+        int won = 0;
+        int stuck = 0;
+        int lost = 0;
+        long steps = 0;
+        long guesses = 0;
+        double wall_seconds = 0;  // Elapsed time of the whole run
+    };
+
+    /**
+     * @param threadCount Number of worker threads; 0 uses the hardware concurrency
+     * @param guess Open the safest cell when no certain move is left, instead of stopping
+     */
+    explicit GameRunner(unsigned threadCount = 0, bool guess = false);
+
+    /**
+     * Get the number of worker threads.
+     * @return The worker count
+     */
+    unsigned threadCount() const;
+
+    /**
+     * Play count games of the same size. Game i is seeded with firstSeed + i,
+     * so results do not depend on the thread count or scheduling.
+     * @param rows Board rows
+     * @param cols Board columns
+     * @param mines Number of mines
+     * @param firstSeed Seed of the first game
+     * @param count Number of games
+     * @param results Output, one entry per game in seed order
+     * @return Totals over all games
+     */
+    Summary run(int rows, int cols, int mines, uint64_t firstSeed, int count,
+                std::vector<GameResult>& results) const;
+
+    /**
+     * Play one game on the calling thread: open the centre cell, then run
+     * MinesweeperSolver::solveUntilStuck() on it.
+     * @param board Board to reset and play on
+     * @param seed Seed of the game
+     * @param guess Open the safest cell when no certain move is left, instead of stopping
+     * @return The result
+     */
+    static GameResult play(MSBoard& board, uint64_t seed, bool guess = false);
+
+private:
+    unsigned thread_count;
+    bool guess_enabled;
+};
+
+#endif // GAME_RUNNER_HPP
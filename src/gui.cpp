@@ -1,11 +1,12 @@
 #include <SFML/Graphics.hpp>
 #include "minesweeper_class.hpp"
+#include "minesweeper_solver.hpp"
 #include "arma_helper.hpp"
 #include <iostream>
 #include <string>
 
 // Forward declaration of solve function
-void solve(MSBoard& board, int x);
+bool solve(MSBoard& board);
 
 int main() {
     int rows = 14, cols = 18, mines = 40;
@@ -31,46 +32,49 @@ int main() {
     buttonText.setPosition(sf::Vector2f(cols * cellSize / 2 - 70, rows * cellSize + 10));
 
     bool needsRedraw = true;
-    bool tryNoRREF = false;
+    std::string gameOverText = "Game Over";
     while (window.isOpen()) {
         sf::Event event;
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed)
                 window.close();
+            if (board.isLost()) {
+                // The game is over: the board stays on screen but takes no more moves
+                continue;
+            }
             if (event.type == sf::Event::MouseButtonPressed) {
                 sf::Vector2i mousePos = sf::Mouse::getPosition(window);
                 if (mousePos.y > rows * cellSize) {
                     // Button clicked
-                    std::vector<std::vector<int>> before = board.revealedBoard;
-                    solve(board, tryNoRREF ? 2 : 0);
-                    if (board.revealedBoard == before && !tryNoRREF) {
-                        tryNoRREF = true;
-                        solve(board, 2); // Try without row reduction
-                    } else {
-                        tryNoRREF = false;
-                    }
-                    needsRedraw = true;
+                    needsRedraw = solve(board);
                 } else {
                     // Board click: open cell
                     int r = mousePos.y / cellSize;
                     int c = mousePos.x / cellSize;
                     if (r >= 0 && r < rows && c >= 0 && c < cols) {
-                        board.open(r, c);
+                        if (board.open(r, c) == MSBoard::OpenResult::Mine) {
+                            std::cout << "Mine hit at (" << r << ", " << c << ")" << std::endl;
+                        }
                         needsRedraw = true;
                     }
                 }
             } else if (event.type == sf::Event::KeyPressed) {
-                if (event.key.code == sf::Keyboard::Space || event.key.code == sf::Keyboard::Enter) {
-                    // Space bar or Enter key pressed
-                    std::vector<std::vector<int>> before = board.revealedBoard;
-                    solve(board, tryNoRREF ? 2 : 0);
-                    if (board.revealedBoard == before && !tryNoRREF) {
-                        tryNoRREF = true;
-                        solve(board, 2); // Try without row reduction
-                    } else {
-                        tryNoRREF = false;
+                if (event.key.code == sf::Keyboard::Space) {
+                    // Space bar solves one layer, like the button
+                    needsRedraw = solve(board);
+                } else if (event.key.code == sf::Keyboard::Enter) {
+                    // Enter solves until no certain move is left
+                    needsRedraw = MinesweeperSolver::solveUntilStuck(board).steps > 0;
+                } else if (event.key.code == sf::Keyboard::G) {
+                    // G plays on, opening the safest cell whenever nothing is certain
+                    MinesweeperSolver::Budget budget;
+                    budget.guess = true;
+                    MinesweeperSolver::RunResult result = MinesweeperSolver::solveUntilStuck(board, budget);
+                    if (result.stop == MinesweeperSolver::RunResult::Stop::Lost) {
+                        std::cout << "A guess hit a mine after " << result.guesses << " guesses" << std::endl;
+                        gameOverText = "Game Over: guess hit a mine";
                     }
-                    needsRedraw = true;
+                    needsRedraw = result.steps > 0 || board.isLost();
                 }
             }
         }
@@ -81,8 +85,11 @@ int main() {
                 for (int c = 0; c < cols; ++c) {
                     sf::RectangleShape cell(sf::Vector2f(cellSize - margin, cellSize - margin));
                     cell.setPosition(sf::Vector2f(c * cellSize + margin / 2, r * cellSize + margin / 2));
-                    int val = board.revealedBoard[r][c];
-                    if (val == -1) {
+                    int val = board.revealedBoard(r, c);
+                    bool hiddenMine = board.isLost() && val == -1 && board.board(r, c) == -1;
+                    if (hiddenMine) {
+                        cell.setFillColor(sf::Color(120, 40, 40)); // Mine shown after the game is lost
+                    } else if (val == -1) {
                         cell.setFillColor(sf::Color(180, 180, 180)); // Covered
                     } else if (val == -2) {
                         cell.setFillColor(sf::Color(255, 100, 100)); // Marked as mine
@@ -97,6 +104,11 @@ int main() {
                             num.setPosition(sf::Vector2f(c * cellSize + 10, r * cellSize + 5));
                             window.draw(num);
                         }
+                    } else if (hiddenMine) {
+                        sf::Text mine("*", font, 18);
+                        mine.setFillColor(sf::Color::White);
+                        mine.setPosition(sf::Vector2f(c * cellSize + 10, r * cellSize + 5));
+                        window.draw(mine);
                     } else if (val == -2) {
                         sf::Text mine("M", font, 18);
                         mine.setFillColor(sf::Color::Red);
@@ -105,7 +117,12 @@ int main() {
                     }
                 }
             }
-            // Draw button
+            // Draw button; it turns into the game-over banner once a mine is hit
+            if (board.isLost()) {
+                button.setFillColor(sf::Color(200, 80, 80));
+                buttonText.setString(gameOverText);
+                buttonText.setPosition(sf::Vector2f(10, rows * cellSize + 10));
+            }
             window.draw(button);
             window.draw(buttonText);
             window.display();
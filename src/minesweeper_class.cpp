@@ -2,98 +2,157 @@
 #include <vector>
 #include <cstdlib>
 #include <ctime>
+#include <utility>
 #include "minesweeper_class.hpp"
-#include <SFML/Graphics.hpp>
 
-MSBoard::MSBoard(int numRows, int numCols, int numMines) {
+MSBoard::MSBoard(int numRows, int numCols, int numMines)
+    : MSBoard(numRows, numCols, numMines, static_cast<uint64_t>(std::time(0))) {
+    printf("Seed: %llu\n", static_cast<unsigned long long>(gameSeed));
+}
+
+MSBoard::MSBoard(int numRows, int numCols, int numMines, uint64_t seed) {
     rows = numRows;
     cols = numCols;
     mines = numMines;
-    board = std::vector<std::vector<int>>(rows, std::vector<int>(cols, 0));
-    revealedBoard = std::vector<std::vector<int>>(rows, std::vector<int>(cols, -1)); 
-    unsigned int x = std::time(0);
-    // x = 1747481856;
-    std::srand(x); // Seed for random number generation
-    printf("Seed: %d\n", x);
+    requestedMines = numMines;
+    board.reset(rows, cols, 0);
+    revealedBoard.reset(rows, cols, -1);
+    floodQueue.reserve(static_cast<size_t>(rows) * cols);
+    unrevealedCells = rows * cols;
+    gameSeed = seed;
+    rng.reseed(seed);
+}
+
+void MSBoard::reset(uint64_t seed) {
+    board.fill(0);
+    revealedBoard.fill(-1);
+    changeLog.clear();
+    floodQueue.clear();
+    started = false;
+    exploded = false;
+    mines = requestedMines;
+    unrevealedCells = rows * cols;
+    flaggedCells = 0;
+    gameSeed = seed;
+    rng.reseed(seed);
 }
 
-void MSBoard::open(int row, int col) {
-    revealedBoard[row][col] = board[row][col];
+uint64_t MSBoard::seed() const {
+    return gameSeed;
+}
+
+MSBoard::OpenResult MSBoard::open(int row, int col) {
     if (!started) {
         MSBoard::placeMines(row, col);
         started = true;
     }
-    if (board[row][col] == -1) {
-        printf("Game Over!");
-        exit(0);
-        // Game over
-        for (int r = 0; r < rows; ++r) {
-            for (int c = 0; c < cols; ++c) {
-                revealedBoard[r][c] = board[r][c];
+    floodQueue.clear();
+    if (board(row, col) == -1) {
+        // The cell stays unrevealed; the game is lost and the caller decides what to do
+        exploded = true;
+        return OpenResult::Mine;
+    }
+    // Breadth-first reveal: every revealed zero opens its unrevealed neighbours.
+    // The queue doubles as the list of revealed cells. Border cells are never
+    // unrevealed and flagged cells are left alone, so no bounds checks are needed.
+    int start = board.index(row, col);
+    if (revealedBoard[start] != board[start]) {
+        setRevealed(start, board[start]);
+        floodQueue.push_back(start);
+    }
+    const auto& offsets = board.neighborOffsets();
+    for (size_t head = 0; head < floodQueue.size(); ++head) {
+        int cell = floodQueue[head];
+        if (board[cell] != 0) continue;
+        for (int offset : offsets) {
+            int neighbor = cell + offset;
+            if (revealedBoard[neighbor] == -1) {
+                setRevealed(neighbor, board[neighbor]);
+                floodQueue.push_back(neighbor);
             }
         }
     }
+    return OpenResult::Safe;
+}
+
+const std::vector<int>& MSBoard::revealedCells() const {
+    return floodQueue;
+}
+
+bool MSBoard::isLost() const {
+    return exploded;
 }
 
 void MSBoard::markMine(int row, int col) {
-    if (revealedBoard[row][col] == -1) {
-        revealedBoard[row][col] = -2;
+    if (revealedBoard(row, col) == -1) {
+        setRevealed(revealedBoard.index(row, col), -2);
     }
 }
 
+const std::vector<int>& MSBoard::changedCells() const {
+    return changeLog;
+}
+
+void MSBoard::setRevealed(int index, int value) {
+    int previous = revealedBoard[index];
+    if (previous == value) return;
+
+    unrevealedCells += (value == -1) - (previous == -1);
+    flaggedCells += (value == -2) - (previous == -2);
+    revealedBoard[index] = value;
+    changeLog.push_back(index);
+}
+
 void MSBoard::placeMines(int row, int col) {
-    int placedMines = 0;  
-    while (placedMines < mines) {
-        int r = std::rand() % rows;
-        int c = std::rand() % cols;
-
-        // Check if the position is valid for placing a mine
-        if (board[r][c] == 0 && !isAdjacent(r, c, row, col) && !(r == row && c == col)) {
-            board[r][c] = -1; // Place a mine
-            placedMines++;
-        }
-    }
-    for (int i = 0; i < this->rows; i++) {
-        for (int j = 0; j < this->cols; j++) {
-            if (board[i][j] != -1) {
-                int count = 0;
-                for (int dr = -1; dr <= 1; ++dr) {
-                    for (int dc = -1; dc <= 1; ++dc) {
-                        int nr = i + dr;
-                        int nc = j + dc;
-                        if (nr >= 0 && nr < this->rows && nc >= 0 && nc < this->cols) {
-                            if (board[nr][nc] == -1) {
-                                count++;
-                            }
-                        }
-                    }
-                }
-                board[i][j] = count;
+    // Every cell outside the 3x3 around the first click is a candidate
+    candidates.clear();
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (std::abs(r - row) > 1 || std::abs(c - col) > 1) {
+                candidates.push_back(board.index(r, c));
             }
         }
     }
-}
 
-bool MSBoard::isAdjacent(int r, int c, int initialRow, int initialCol) {
-    for (int dr = -1; dr <= 1; ++dr) {
-        for (int dc = -1; dc <= 1; ++dc) {
-            int nr = initialRow + dr;
-            int nc = initialCol + dc;
-            if (nr == r && nc == c) {
-                return true;
-            }
-        }
+    // Partial Fisher-Yates: the first `mines` slots become a uniform sample.
+    // If the requested mines do not fit, every candidate gets one and `mines`
+    // is lowered to match, so that counts derived from it stay correct.
+    const int count = static_cast<int>(candidates.size());
+    const int placed = requestedMines < count ? requestedMines : count;
+    mines = placed;
+    for (int i = 0; i < placed; ++i) {
+        int j = i + static_cast<int>(rng.below(count - i));
+        std::swap(candidates[i], candidates[j]);
+        board[candidates[i]] = -1;
     }
-    return false;
-}
 
-bool MSBoard::isSolved() {
-    for (int r = 0; r < this->rows; r++) {
-        for (int c = 0; c < this->cols; c++) {
-            if (revealedBoard[r][c] == -1) return false;
+    // Neighbour mine counts, 64 cells at a time; the border never holds -1
+    minePlane.assign(board, [](int8_t value) { return value == -1; });
+    safePlane.assign(board, [](int8_t value) { return value == 0; });
+    const auto& offsets = board.neighborOffsets();
+    for (size_t w = 0; w < safePlane.wordCount(); ++w) {
+        uint64_t cells = safePlane.word(w);
+        if (cells == 0) continue;
+        BitPlane::Counter count = minePlane.countNeighbors(w, offsets);
+        for (; cells != 0; cells &= cells - 1) {
+            int lane = __builtin_ctzll(cells);
+            board[static_cast<int>(w * 64 + lane)] = count.value(lane);
         }
     }
-    return true;
+}
+
+bool MSBoard::isSolved() const {
+    // Mines are never revealed, so the cells not yet open are all mines
+    // exactly when there are as many of them as mines
+    return started && !exploded && unrevealedCells + flaggedCells == mines;
+}
+
+int MSBoard::unrevealedCount() const {
+    return unrevealedCells;
+}
+
+int MSBoard::flaggedCount() const {
+    return flaggedCells;
 }
 
 // int main() {
@@ -109,8 +168,9 @@ bool MSBoard::isSolved() {
 //     board.open(6, 6);
 
 //     // Print the board for debugging
-//     for (const auto& row : board.revealedBoard) {
-//         for (int cell : row) {
+//     for (int r = 0; r < board.rows; ++r) {
+//         for (int c = 0; c < board.cols; ++c) {
+//             int cell = board.revealedBoard(r, c);
 //             if (cell == -1) printf("*");
 //             else printf("%d", cell);
 //             printf(" ");
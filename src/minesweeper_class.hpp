@@ -1,18 +1,57 @@
+#include <cstdint>
 #include <vector>
+#include "../include/board_grid.hpp"
+#include "../include/bit_plane.hpp"
+#include "../include/xoshiro256.hpp"
 
 class MSBoard {
     public:
-        std::vector<std::vector<int>> revealedBoard;
+        BoardGrid revealedBoard;
         int rows;
         int cols;
+        // Mines on the board; lowered on the first open if the requested
+        // count does not fit outside the 3x3 around the first click.
         int mines;
+        // Seeded from the clock; the seed is printed so the game can be replayed.
         MSBoard(int numRows, int numCols, int numMines);
-        void open(int row, int col);
+        MSBoard(int numRows, int numCols, int numMines, uint64_t seed);
+        // Start a new game of the same size in place, reusing all storage.
+        void reset(uint64_t seed);
+        uint64_t seed() const;
+        // Result of opening a cell, returned instead of ending the process.
+        enum class OpenResult { Safe, Mine };
+        // Opening a mine loses the game and leaves the cell unrevealed. Opening
+        // a zero also reveals its neighbours, cascading through connected zeros.
+        OpenResult open(int row, int col);
+        // Cell indices revealed by the last open(), in breadth-first order;
+        // empty if it hit a mine.
+        const std::vector<int>& revealedCells() const;
+        bool isLost() const;
         void markMine(int row, int col);
-        std::vector<std::vector<int>> board;
+        BoardGrid board;
         bool started = false;
-        bool isSolved ();
+        // True once every safe cell is open, whether or not the mines are
+        // marked; O(1). A mine enclosed by mines may never be marked.
+        bool isSolved() const;
+        // Live counts, kept up to date by every open and mark.
+        int unrevealedCount() const;
+        int flaggedCount() const;
+        // Cell indices of revealedBoard in the order they were opened or marked.
+        // Append-only; a reader remembers how many entries it has seen.
+        const std::vector<int>& changedCells() const;
     private:
+        std::vector<int> changeLog;
+        uint64_t gameSeed;
+        int requestedMines = 0;
+        bool exploded = false;
+        int unrevealedCells = 0;
+        int flaggedCells = 0;
+        Xoshiro256 rng;
+        // open and placeMines buffers, kept so that new games allocate nothing
+        std::vector<int> candidates;
+        std::vector<int> floodQueue;
+        BitPlane minePlane;
+        BitPlane safePlane;
+        void setRevealed(int index, int value);
         void placeMines(int row, int col);
-        bool isAdjacent(int r, int c, int initialRow, int initialCol);
 };
\ No newline at end of file
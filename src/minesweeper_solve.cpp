@@ -1,7 +1,6 @@
 #include <iostream>
 #include <vector>
 #include <list>
-#define ARMA_DONT_USE_STD_MUTEX
 #include <armadillo>
 #include "minesweeper_class.hpp"   
 #include "minesweeper_solver.hpp"
@@ -11,8 +10,8 @@
  * This function now delegates to the new modular MinesweeperSolver class.
  * 
  * @param board Reference to the Minesweeper board to solve
- * @param x The iteration number (used for RREF skipping)
+ * @return True if any progress was made, false otherwise
  */
-void solve(MSBoard& board, int x) {
-    MinesweeperSolver::solve(board, x);
+bool solve(MSBoard& board) {
+    return MinesweeperSolver::solve(board);
 }
\ No newline at end of file
@@ -5,6 +5,6 @@
  * This function delegates to the new modular MinesweeperSolver class.
  * 
  * @param board Reference to the Minesweeper board to solve
- * @param x The iteration number (used for RREF skipping)
+ * @return True if any progress was made, false otherwise
  */
-void solve(MSBoard& board, int x);
\ No newline at end of file
+bool solve(MSBoard& board);
\ No newline at end of file
@@ -3,99 +3,445 @@
 #include "../include/equation_builder.hpp"
 #include "../include/rref_processor.hpp"
 #include "../include/arma_helper.hpp"
+#include "../include/integer_rref.hpp"
+#include "../include/frontier_components.hpp"
+#include "../include/work_stealing_pool.hpp"
+#include "../include/presolve.hpp"
+#include "../include/bitboard_rules.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 #include <stdexcept>
 
-bool MinesweeperSolver::solve(MSBoard& board, int iteration) {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+bool MinesweeperSolver::solve(MSBoard& board, RREFEngine engine) {
     // Validate board state
-    if (!validateBoard(board)) {
+    if (!validateBoard(board) || board.isLost()) {
         return false;
     }
 
-    // Store initial state for comparison
-    std::vector<std::vector<int>> initial_state = board.revealedBoard;
-    int rows = initial_state.size();
-    int cols = initial_state[0].size();
-
     try {
-        // Identify unrevealed squares
-        TwoWayDict unrevealed_indices = EquationBuilder::identifyUnrevealedSquares(initial_state, rows, cols);
-        
-        if (unrevealed_indices.size() == 0) {
-            return false; // No unrevealed squares to process
+        // Single-cell rules run to a fixpoint before any equations are built
+        Workspace& space = workspace();
+        auto start = Clock::now();
+        StepContext step;
+        step.rule_cells = applyRules(board, space);
+        space.scheduler.record(AdaptiveScheduler::Tier::Rules, step.rule_cells, secondsSince(start));
+        if (board.isLost()) return true;
+
+        // Identify unrevealed squares and create equations in a single pass
+        auto built = Clock::now();
+        EquationBuilder::buildEquations(board.revealedBoard, space.unrevealed_indices, space.equations);
+        space.scheduler.record(AdaptiveScheduler::Tier::Equations, 0, secondsSince(built));
+
+        step.cheap_seconds = secondsSince(start);
+        deduce(engine, space, space.analysis, &step);
+        return apply(board, space.analysis) > 0 || step.rule_cells > 0;
+
+    } catch (const std::exception& e) {
+        // Log error in a real implementation
+        return false;
+    }
+}
+
+int MinesweeperSolver::applyRules(MSBoard& board, Workspace& space) {
+    BitboardRules::Stats stats = space.rules.run(board);
+    return stats.mines + stats.safe;
+}
+
+AdaptiveScheduler& MinesweeperSolver::scheduler() {
+    return workspace().scheduler;
+}
+
+void MinesweeperSolver::analyze(const BoardGrid& position, Analysis& result, RREFEngine engine) {
+    Workspace& space = workspace();
+    EquationBuilder::buildEquations(position, space.unrevealed_indices, space.equations);
+    deduce(engine, space, result, nullptr);
+}
+
+void MinesweeperSolver::probabilities(const MSBoard& board, Probabilities& result) {
+    Workspace& space = workspace();
+    EquationBuilder::buildEquations(board.revealedBoard, space.unrevealed_indices, space.equations);
+    computeProbabilities(board, space, result);
+}
+
+MinesweeperSolver::Analysis MinesweeperSolver::analyze(const BoardGrid& position) {
+    Analysis result;
+    analyze(position, result);
+    return result;
+}
+
+int MinesweeperSolver::apply(MSBoard& board, const Analysis& analysis) {
+    const BoardGrid& state = board.revealedBoard;
+    int changed = 0;
+    for (int cell : analysis.mines) {
+        if (state[cell] != SolverConstants::UNREVEALED) continue;
+        board.markMine(state.row(cell), state.col(cell));
+        ++changed;
+    }
+    for (int cell : analysis.safe) {
+        if (state[cell] != SolverConstants::UNREVEALED) continue;
+        board.open(state.row(cell), state.col(cell));
+        ++changed;
+    }
+    return changed;
+}
+
+void MinesweeperSolver::deduce(RREFEngine engine, Workspace& space, Analysis& result, const StepContext* step) {
+    const TwoWayDict& unrevealed_indices = space.unrevealed_indices;
+    const EquationSystem& equations = space.equations;
+    result.safe.clear();
+    result.mines.clear();
+    result.stats = Analysis::Stats();
+    result.stats.variables = unrevealed_indices.size();
+    result.stats.equations = equations.equationCount();
+
+    if (result.stats.variables == 0 || result.stats.equations == 0) {
+        return; // Nothing to deduce from
+    }
+
+    // Presolve settles the easy rows; only what is left can go through row reduction
+    auto start = Clock::now();
+    space.presolve_deductions.clear();
+    space.deductions.clear();
+    result.stats.presolve = space.presolve.run(equations, space.presolved, space.presolve_deductions);
+    const int presolved_cells = static_cast<int>(space.presolve_deductions.size());
+    double cheap_seconds = secondsSince(start);
+    if (step) {
+        space.scheduler.record(AdaptiveScheduler::Tier::Presolve, presolved_cells, cheap_seconds);
+        cheap_seconds += step->cheap_seconds;
+    }
+
+    FrontierComponents::split(space.presolved, space.components, space.split_scratch);
+    const double cost = eliminationCost(space.components);
+
+    bool stalled = !step || (step->rule_cells == 0 && presolved_cells == 0);
+    bool eliminate = cost > 0 && (!step || space.scheduler.shouldEliminate(stalled, cost, cheap_seconds));
+    auto eliminated = Clock::now();
+    if (eliminate) {
+        deduceFromComponents(engine, space);
+        result.stats.components = static_cast<int>(space.components.size());
+        result.stats.row_reduced = true;
+    } else if (step && cost > 0) {
+        space.scheduler.recordSkip(AdaptiveScheduler::Tier::Elimination);
+    }
+    const double elimination_seconds = secondsSince(eliminated);
+
+    collectCells(space, result);
+
+    // Presolve substitutes out what it fixes, so elimination only finds new cells
+    if (step && eliminate) {
+        int cells = static_cast<int>(result.safe.size() + result.mines.size()) - presolved_cells;
+        space.scheduler.record(AdaptiveScheduler::Tier::Elimination, cells > 0 ? cells : 0,
+                               elimination_seconds, cost);
+    }
+}
+
+void MinesweeperSolver::collectCells(Workspace& space, Analysis& result) {
+    result.safe.clear();
+    result.mines.clear();
+    for (const auto* list : {&space.presolve_deductions, &space.deductions}) {
+        for (const auto& deduction : *list) {
+            int cell = space.unrevealed_indices.get_key(deduction.variable);
+            (deduction.is_mine ? result.mines : result.safe).push_back(cell);
         }
+    }
+
+    // A cell can be implied by several rows; report it once
+    for (auto* cells : {&result.safe, &result.mines}) {
+        std::sort(cells->begin(), cells->end());
+        cells->erase(std::unique(cells->begin(), cells->end()), cells->end());
+    }
 
-        // Create equations
-        std::vector<std::vector<int>> equations = EquationBuilder::createEquations(initial_state, unrevealed_indices, rows, cols);
-        
-        if (equations.empty() || equations[0].empty()) {
-            return false; // No equations to solve
+    // Only an inconsistent position can force a cell both ways; decide neither
+    space.conflicts.clear();
+    std::set_intersection(result.safe.begin(), result.safe.end(), result.mines.begin(), result.mines.end(),
+                          std::back_inserter(space.conflicts));
+    if (!space.conflicts.empty()) {
+        result.stats.conflicts = static_cast<int>(space.conflicts.size());
+        auto conflicting = [&](int cell) {
+            return std::binary_search(space.conflicts.begin(), space.conflicts.end(), cell);
+        };
+        for (auto* cells : {&result.safe, &result.mines}) {
+            cells->erase(std::remove_if(cells->begin(), cells->end(), conflicting), cells->end());
         }
+    }
+}
 
-        // Process equations
-        if (shouldSkipRREF(iteration)) {
-            // Process without RREF (original equations)
-            RREFProcessor::processRREF(equations, unrevealed_indices, board, cols);
-        } else {
-            // Compute RREF and process
-            arma::mat A = convert_to_arma_mat(equations);
-            arma::mat RREF = compute_rref(A);
-            std::vector<std::vector<int>> rrefVector = convert_to_vector(RREF);
-            
-            RREFProcessor::processRREF(rrefVector, unrevealed_indices, board, cols);
+void MinesweeperSolver::computeProbabilities(const MSBoard& board, Workspace& space, Probabilities& result) {
+    // The raw equations: presolve drops rows that only matter for counting layouts
+    FrontierComponents::split(space.equations, space.components, space.split_scratch);
+    const int variables = space.unrevealed_indices.size();
+    result.interior_cells = board.unrevealedCount() - variables;
+    result.stats = space.probability.compute(space.components, variables, result.interior_cells,
+                                             board.mines - board.flaggedCount(),
+                                             space.serial ? nullptr : &componentPool(),
+                                             result.mine, result.interior);
+    result.cells.resize(result.mine.size());
+    for (size_t v = 0; v < result.mine.size(); ++v) {
+        result.cells[v] = space.unrevealed_indices.get_key(static_cast<int>(v));
+    }
+}
+
+int MinesweeperSolver::playProbabilities(MSBoard& board, Workspace& space, RunResult& run) {
+    Probabilities& odds = space.probabilities;
+    computeProbabilities(board, space, odds);
+    if (!odds.stats.exact || !odds.stats.feasible) {
+        return 0;
+    }
+
+    // Cells off the frontier, in board order
+    const BoardGrid& state = board.revealedBoard;
+    std::vector<int>& interior = space.interior;
+    interior.clear();
+    if (odds.interior_cells > 0) {
+        for (size_t index = 0; index < state.size(); ++index) {
+            if (state[index] == SolverConstants::UNREVEALED &&
+                space.unrevealed_indices.find_value(static_cast<int>(index)) < 0) {
+                interior.push_back(static_cast<int>(index));
+            }
         }
+    }
 
-        // Check if any progress was made
-        return hasBoardChanged(initial_state, board.revealedBoard);
+    // The mine count can decide cells the equations alone could not
+    Analysis& certain = space.analysis;
+    certain.safe.clear();
+    certain.mines.clear();
+    for (size_t v = 0; v < odds.cells.size(); ++v) {
+        if (odds.mine[v] == 0) certain.safe.push_back(odds.cells[v]);
+        if (odds.mine[v] == 1) certain.mines.push_back(odds.cells[v]);
+    }
+    if (odds.interior == 0) certain.safe.insert(certain.safe.end(), interior.begin(), interior.end());
+    if (odds.interior == 1) certain.mines.insert(certain.mines.end(), interior.begin(), interior.end());
+    if (!certain.safe.empty() || !certain.mines.empty()) {
+        for (auto* cells : {&certain.safe, &certain.mines}) {
+            std::sort(cells->begin(), cells->end());
+        }
+        return apply(board, certain);
+    }
 
-    } catch (const std::exception& e) {
-        // Log error in a real implementation
-        return false;
+    // Otherwise guess the cell least likely to be a mine; ties go to the frontier
+    int best = -1;
+    double lowest = 2;
+    for (size_t v = 0; v < odds.cells.size(); ++v) {
+        if (odds.mine[v] < lowest) {
+            lowest = odds.mine[v];
+            best = odds.cells[v];
+        }
     }
+    if (!interior.empty() && odds.interior < lowest) {
+        best = interior.front();
+    }
+    if (best < 0) {
+        return 0;
+    }
+    board.open(state.row(best), state.col(best));
+    ++run.guesses;
+    return 1;
 }
 
-bool MinesweeperSolver::validateBoard(const MSBoard& board) {
-    if (board.revealedBoard.empty()) {
-        return false;
+double MinesweeperSolver::eliminationCost(const std::vector<EquationComponent>& components) {
+    double cost = 0;
+    for (const auto& component : components) {
+        double rows = component.equations.equationCount();
+        double columns = component.equations.variableCount();
+        cost += rows * columns * std::min(rows, columns);
     }
-    
-    int rows = board.revealedBoard.size();
-    int cols = board.revealedBoard[0].size();
-    
-    if (rows <= 0 || cols <= 0) {
-        return false;
+    return cost;
+}
+
+MinesweeperSolver::RunResult MinesweeperSolver::solveUntilStuck(MSBoard& board, Budget budget, RREFEngine engine) {
+    using Tier = AdaptiveScheduler::Tier;
+    RunResult run;
+    if (!validateBoard(board)) {
+        return run;
     }
-    
-    // Check that all rows have the same number of columns
-    for (const auto& row : board.revealedBoard) {
-        if (row.size() != static_cast<size_t>(cols)) {
+
+    auto start = Clock::now();
+    Workspace& space = workspace();
+
+    // Count a tier run in the result and in the thread's scheduler
+    auto note = [&](Tier tier, int cells, Clock::time_point since, double cost = 0) {
+        double seconds = secondsSince(since);
+        run.tiers[static_cast<int>(tier)].add(cells, seconds);
+        space.scheduler.record(tier, cells, seconds, cost);
+        run.steps += cells > 0;
+        return cells > 0;
+    };
+
+    // Check whether the run is over before the next tier
+    auto finished = [&] {
+        if (board.isLost()) {
+            run.stop = RunResult::Stop::Lost;
+        } else if (board.isSolved()) {
+            run.stop = RunResult::Stop::Solved;
+        } else if ((budget.max_steps > 0 && run.steps >= budget.max_steps) ||
+                   (budget.max_seconds > 0 && secondsSince(start) >= budget.max_seconds)) {
+            run.stop = RunResult::Stop::Budget;
+        } else {
             return false;
         }
+        return true;
+    };
+
+    try {
+        bool loaded = false;
+        while (!finished()) {
+            // The rules run to their own fixpoint, so the next tier follows either way.
+            // Later rounds read only the cells logged since the previous one.
+            auto tier = Clock::now();
+            BitboardRules::Stats rules = loaded ? space.rules.resume(board) : space.rules.run(board);
+            loaded = true;
+            note(Tier::Rules, rules.mines + rules.safe, tier);
+            if (finished()) break;
+
+            // A full rebuild only visits the revealed cells next to the frontier,
+            // which is fewer than a round's changes would dirty (up to nine each)
+            tier = Clock::now();
+            EquationBuilder::buildEquations(board.revealedBoard, space.unrevealed_indices, space.equations);
+            note(Tier::Equations, 0, tier);
+
+            if (space.unrevealed_indices.size() > 0 && space.equations.equationCount() > 0) {
+                // Subset rules: presolve alone, applied before anything is row-reduced
+                tier = Clock::now();
+                space.presolve_deductions.clear();
+                space.deductions.clear();
+                space.analysis.stats = Analysis::Stats();
+                space.analysis.stats.presolve = space.presolve.run(space.equations, space.presolved,
+                                                                   space.presolve_deductions);
+                collectCells(space, space.analysis);
+                if (note(Tier::Presolve, apply(board, space.analysis), tier)) continue;
+
+                // Row reduction of the components presolve left
+                tier = Clock::now();
+                space.presolve_deductions.clear();
+                FrontierComponents::split(space.presolved, space.components, space.split_scratch);
+                const double cost = eliminationCost(space.components);
+                deduceFromComponents(engine, space);
+                collectCells(space, space.analysis);
+                if (note(Tier::Elimination, apply(board, space.analysis), tier, cost)) continue;
+            }
+
+            // Nothing certain is left from the equations alone
+            tier = Clock::now();
+            if (!budget.guess || !note(Tier::Probability, playProbabilities(board, space, run), tier)) {
+                run.stop = RunResult::Stop::Stuck;
+                break;
+            }
+        }
+    } catch (const std::exception& e) {
+        run.stop = RunResult::Stop::Stuck;
     }
-    
-    return true;
+
+    run.seconds = secondsSince(start);
+    return run;
 }
 
-bool MinesweeperSolver::hasBoardChanged(const std::vector<std::vector<int>>& old_state,
-                                       const std::vector<std::vector<int>>& new_state) {
-    if (old_state.size() != new_state.size()) {
-        return true;
+MinesweeperSolver::RunResult MinesweeperSolver::solveUntilStuck(MSBoard& board) {
+    return solveUntilStuck(board, Budget(), RREFEngine::ExactInteger);
+}
+
+const AdaptiveScheduler::Counters& MinesweeperSolver::RunResult::tier(AdaptiveScheduler::Tier tier) const {
+    return tiers[static_cast<int>(tier)];
+}
+
+bool MinesweeperSolver::validateBoard(const MSBoard& board) {
+    // A BoardGrid is rectangular by construction, so only its size needs checking
+    return !board.revealedBoard.empty() &&
+           board.revealedBoard.rows() == board.rows && board.revealedBoard.cols() == board.cols;
+}
+
+void MinesweeperSolver::deduceFromComponents(RREFEngine engine, Workspace& space) {
+    // Independent blocks share no variables, so each one is reduced on its own
+    std::vector<EquationComponent>& components = space.components;
+    space.results.resize(components.size());
+    for (auto& result : space.results) {
+        result.clear();
     }
-    
-    for (size_t i = 0; i < old_state.size(); ++i) {
-        if (old_state[i].size() != new_state[i].size()) {
-            return true;
+
+    auto solveComponent = [&](size_t index, unsigned threadCount) {
+        // Every thread reduces into its own buffers
+        thread_local EquationSystem reduced;
+        const EquationComponent& component = components[index];
+        std::vector<RREFProcessor::Deduction>& result = space.results[index];
+        if (component.equations.equationCount() == 0) return; // A variable presolve removed
+        reduceComponent(component.equations, engine, threadCount, reduced);
+        RREFProcessor::collectDeductions(reduced, result);
+        for (auto& deduction : result) {
+            deduction.variable = component.variables[deduction.variable];
         }
-        
-        for (size_t j = 0; j < old_state[i].size(); ++j) {
-            if (old_state[i][j] != new_state[i][j]) {
-                return true;
-            }
+    };
+
+    // A component big enough for parallel elimination gets every thread to itself.
+    // The rest are spread over the pool; elimination cost grows with rows * columns * rank.
+    std::vector<size_t>& pooled = space.pooled;
+    std::vector<size_t>& costs = space.costs;
+    pooled.clear();
+    costs.clear();
+    size_t total_cost = 0;
+    for (size_t i = 0; i < components.size(); ++i) {
+        size_t rows = components[i].equations.equationCount();
+        size_t columns = components[i].equations.variableCount();
+        if (engine == RREFEngine::ExactInteger && !space.serial &&
+            rows * (columns + 1) >= IntegerRREF::PARALLEL_ELIMINATION_MIN_ENTRIES) {
+            solveComponent(i, 0);
+            continue;
         }
+        pooled.push_back(i);
+        costs.push_back(rows * columns * std::min(rows, columns));
+        total_cost += costs.back();
     }
-    
-    return false;
+
+    if (!space.serial && pooled.size() > 1 &&
+        total_cost >= SolverConstants::PARALLEL_MIN_ELIMINATION_COST) {
+        componentPool().run(costs, [&](size_t index) { solveComponent(pooled[index], 1); });
+    } else {
+        for (size_t index : pooled) {
+            solveComponent(index, 1);
+        }
+    }
+
+    // Merge in component order so the result does not depend on scheduling
+    space.deductions.clear();
+    for (const auto& result : space.results) {
+        space.deductions.insert(space.deductions.end(), result.begin(), result.end());
+    }
+
+    // Rows presolve dropped with their singletons can settle now that more is known
+    space.presolve.recover(space.deductions);
 }
 
-bool MinesweeperSolver::shouldSkipRREF(int iteration) {
-    return (iteration % SolverConstants::RREF_SKIP_FREQUENCY) == SolverConstants::RREF_SKIP_CONDITION;
+void MinesweeperSolver::setSerial(bool serial) {
+    workspace().serial = serial;
+}
+
+MinesweeperSolver::Workspace& MinesweeperSolver::workspace() {
+    thread_local Workspace space;
+    return space;
+}
+
+WorkStealingPool& MinesweeperSolver::componentPool() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+void MinesweeperSolver::reduceComponent(const EquationSystem& equations, RREFEngine engine,
+                                        unsigned threadCount, EquationSystem& reduced) {
+    if (engine == RREFEngine::Armadillo) {
+        arma::mat A = convert_to_arma_mat(equations);
+        arma::mat RREF = compute_rref(A);
+        reduced = convert_to_equation_system(RREF);
+        return;
+    }
+    thread_local IntegerRREF::Workspace rref_workspace;
+    IntegerRREF::compute(equations, reduced, rref_workspace, threadCount);
 }
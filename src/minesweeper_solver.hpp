@@ -2,10 +2,21 @@
 #define MINESWEEPER_SOLVER_HPP
 
 #include "../include/solver_constants.hpp"
+#include "../include/board_grid.hpp"
+#include "../include/equation_system.hpp"
+#include "../include/rref_processor.hpp"
+#include "../include/two_way_dict.hpp"
+#include "../include/frontier_components.hpp"
+#include "../include/presolve.hpp"
+#include "../include/bitboard_rules.hpp"
+#include "../include/adaptive_scheduler.hpp"
+#include "../include/mine_probability.hpp"
+#include <array>
 #include <vector>
 
 // Forward declarations
 class MSBoard;
+class WorkStealingPool;
 
 /**
  * Main solver class for Minesweeper using linear algebra.
@@ -14,13 +25,178 @@ class MSBoard;
  */
 class MinesweeperSolver {
 public:
+    /**
+     * Row reduction engines available to the solver.
+     */
+    enum class RREFEngine {
+        Armadillo,    // Legacy double precision elimination through arma::mat
+        ExactInteger  // Fraction-free integer elimination (IntegerRREF)
+    };
+
+    /**
+     * Deductions about a position, as produced by analyze().
+     */
+    struct Analysis {
+        /**
+         * How the deductions were found.
+         */
+        struct Stats {
+            int variables = 0;         // Frontier cells
+            int equations = 0;         // Revealed cells with unrevealed neighbours
+            int components = 0;        // Independent blocks row-reduced, 0 without row reduction
+            int conflicts = 0;         // Cells deduced both ways (inconsistent position), left out
+            bool row_reduced = false;  // False when elimination was skipped or had nothing to do
+            Presolve::Stats presolve;
+        };
+
+        std::vector<int> safe;   // BoardGrid cell indices that must be safe, ascending and unique
+        std::vector<int> mines;  // BoardGrid cell indices that must be mines, ascending and unique
+        Stats stats;
+    };
+
+    /**
+     * Exact mine probabilities of a position, as produced by probabilities().
+     */
+    struct Probabilities {
+        std::vector<int> cells;     // Frontier cells, as BoardGrid indices
+        std::vector<double> mine;   // Probability that each of cells is a mine
+        double interior = 0;        // Probability that an unrevealed cell off the frontier is a mine
+        int interior_cells = 0;     // Unrevealed, unmarked cells off the frontier
+        MineProbability::Stats stats;
+    };
+
+    /**
+     * Limits for solveUntilStuck(). Zero means no limit.
+     */
+    struct Budget {
+        int max_steps = 0;        // Tier runs that open or mark cells
+        double max_seconds = 0;   // Elapsed time, checked between tiers
+        bool guess = false;       // When every certain tier is stuck, open the safest cell
+    };
+
+    /**
+     * How solveUntilStuck() went.
+     */
+    struct RunResult {
+        /**
+         * Why the run stopped.
+         */
+        enum class Stop {
+            Solved,  // Every safe cell is open, marked mines or not
+            Stuck,   // No tier can decide another cell
+            Lost,    // A mine was opened
+            Budget   // The step or time budget ran out
+        };
+
+        Stop stop = Stop::Stuck;
+        int steps = 0;         // Tier runs that opened or marked cells
+        int guesses = 0;       // Cells opened on their probability alone
+        double seconds = 0;    // Elapsed time of the whole run
+        std::array<AdaptiveScheduler::Counters, AdaptiveScheduler::TIER_COUNT> tiers{};  // By AdaptiveScheduler::Tier
+
+        /**
+         * Get one tier's totals for this run. Cells count the opens and marks the
+         * tier made itself, not the cells a zero's cascade revealed.
+         * @param tier The tier
+         * @return Its counters
+         */
+        const AdaptiveScheduler::Counters& tier(AdaptiveScheduler::Tier tier) const;
+    };
+
+    /**
+     * Find every cell the linear algebra pipeline (presolve and per-component RREF)
+     * can decide, without touching any board. Runs on the calling thread's workspace,
+     * so positions can be analysed from several threads at once; call setSerial() on
+     * those threads to keep them off the shared component pool.
+     * @param position Read-only revealed state, as in MSBoard::revealedBoard
+     * @param result Output deductions and stats; its storage is reused
+     * @param engine The row reduction engine to use
+     */
+    static void analyze(const BoardGrid& position, Analysis& result,
+                        RREFEngine engine = RREFEngine::ExactInteger);
+
+    /**
+     * Same as above, returning a new Analysis.
+     * @param position Read-only revealed state
+     * @return The deductions and stats
+     */
+    static Analysis analyze(const BoardGrid& position);
+
+    /**
+     * Compute the exact mine probability of every unrevealed cell: each frontier
+     * component's layouts are counted exactly (see MineProbability) and weighted by
+     * the ways the remaining mines fit in the cells off the frontier. Components are
+     * counted on the component pool unless setSerial() is in effect, and their
+     * counts are cached per thread, so unchanged components cost nothing on the next call.
+     * @param board The board; its mine count and marks are taken as correct
+     * @param result Output probabilities; its storage is reused. Empty when a component
+     *               is too wide to count or no layout fits (see MineProbability::Stats)
+     */
+    static void probabilities(const MSBoard& board, Probabilities& result);
+
+    /**
+     * Apply an analysis to a board in one batch: mark the mines, then open the
+     * safe cells. Cells that are no longer unrevealed (for example revealed by
+     * an earlier open's cascade) are skipped.
+     * @param board Reference to the Minesweeper board
+     * @param analysis Deductions for the board's current position
+     * @return Number of cells opened or marked
+     */
+    static int apply(MSBoard& board, const Analysis& analysis);
+
     /**
      * Solve the Minesweeper board using linear algebra.
+     * One step runs the single-cell rules, builds the equations and presolves
+     * them; the thread's AdaptiveScheduler decides whether row reduction also runs.
+     * The step ends early if the rules open a mine, and a lost board is not solved.
      * @param board Reference to the Minesweeper board to solve
-     * @param iteration The current iteration number (used for RREF skipping)
+     * @param engine The row reduction engine to use
      * @return True if any progress was made, false otherwise
      */
-    static bool solve(MSBoard& board, int iteration = 0);
+    static bool solve(MSBoard& board, RREFEngine engine = RREFEngine::ExactInteger);
+
+    /**
+     * Solve until no certain move is left, escalating through the tiers cheapest
+     * first: the single-cell rules to a fixpoint, then the subset rules of
+     * presolve on the frontier equations, then per-component RREF on what presolve
+     * leaves, and, if the budget allows guessing, exact probabilities: cells that are
+     * certain once the mine count is taken into account are played, and otherwise
+     * the cell least likely to be a mine is opened. A tier only runs when every tier
+     * before it made no progress, and any
+     * progress sends the run back to the rules. The rule bitplanes are loaded once
+     * per run and then kept up to date from the board's change log; the equations
+     * are rebuilt from the frontier every round. Runs on the
+     * calling thread's workspace and counts every tier in its scheduler() too.
+     * The run counts as solved as soon as every safe cell is open, as MSBoard::isSolved().
+     * @param board Reference to the Minesweeper board to solve
+     * @param budget Limits on the run
+     * @param engine The row reduction engine to use
+     * @return Why the run stopped, with per-tier counts and timings
+     */
+    static RunResult solveUntilStuck(MSBoard& board, Budget budget,
+                                     RREFEngine engine = RREFEngine::ExactInteger);
+
+    /**
+     * Same as above, without limits.
+     * @param board Reference to the Minesweeper board to solve
+     * @return Why the run stopped, with per-tier counts and timings
+     */
+    static RunResult solveUntilStuck(MSBoard& board);
+
+    /**
+     * Keep every solve on the calling thread: no component pool and no parallel
+     * elimination. Meant for threads that each play their own games side by side,
+     * where the shared pool would only add contention. The setting is per thread.
+     * @param serial True to solve serially on this thread
+     */
+    static void setSerial(bool serial);
+
+    /**
+     * Get the calling thread's elimination scheduler, whose per-tier counters
+     * show where solve() and solveUntilStuck() spend their time.
+     * @return The thread-local scheduler; reset() it to start a new measurement
+     */
+    static AdaptiveScheduler& scheduler();
 
 private:
     /**
@@ -31,20 +207,122 @@ private:
     static bool validateBoard(const MSBoard& board);
 
     /**
-     * Check if the board state has changed after processing.
-     * @param old_state The previous board state
-     * @param new_state The current board state
-     * @return True if the board state has changed, false otherwise
+     * What the cheap tiers of the current solve step did, for the scheduler.
+     */
+    struct StepContext {
+        int rule_cells = 0;        // Cells the single-cell rules decided
+        double cheap_seconds = 0;  // Time spent in the rules and equation building
+    };
+
+    /**
+     * Buffers reused by every solve() on the same thread, so that steady-state
+     * solving allocates and converts no matrices.
+     */
+    struct Workspace {
+        bool serial = false;                                         // See setSerial()
+        AdaptiveScheduler scheduler;                                 // See scheduler()
+        MineProbability probability;                                 // Cached component counts
+        Probabilities probabilities;                                 // Probabilities of the current solve
+        BitboardRules rules;                                         // Single-cell rules over bitplanes
+        Analysis analysis;                                           // Deductions of the current solve()
+        TwoWayDict unrevealed_indices;                               // Frontier cell <-> variable
+        EquationSystem equations;                                    // Frontier equations
+        Presolve presolve;
+        EquationSystem presolved;                                    // Rows presolve leaves for RREF
+        std::vector<RREFProcessor::Deduction> presolve_deductions;   // Variables presolve fixed
+        FrontierComponents::Scratch split_scratch;
+        std::vector<EquationComponent> components;
+        std::vector<std::vector<RREFProcessor::Deduction>> results;  // Deductions of each component
+        std::vector<RREFProcessor::Deduction> deductions;            // Merged deductions
+        std::vector<int> conflicts;                                  // Cells deduced both ways
+        std::vector<int> interior;                                   // Unrevealed cells off the frontier
+        std::vector<size_t> pooled;                                  // Components solved on the pool
+        std::vector<size_t> costs;                                   // Estimated cost of each pooled component
+    };
+
+    /**
+     * Get the calling thread's solve() buffers.
+     * @return The thread-local workspace
+     */
+    static Workspace& workspace();
+
+    /**
+     * Apply the single-cell rules to the whole board until they find nothing new.
+     * @param board Reference to the Minesweeper board to solve
+     * @param space Workspace holding the rule engine's bitplanes
+     * @return Number of cells opened or marked
+     */
+    static int applyRules(MSBoard& board, Workspace& space);
+
+    /**
+     * Deduce from the equations in the workspace without touching any board.
+     * @param engine The row reduction engine to use
+     * @param space Workspace holding the frontier mapping and its equations
+     * @param result Output deductions over cell indices, and stats
+     * @param step The current solve step, whose tiers are timed and scheduled; nullptr
+     *             always runs elimination and records nothing (analyze())
+     */
+    static void deduce(RREFEngine engine, Workspace& space, Analysis& result, const StepContext* step);
+
+    /**
+     * Map the presolve and elimination deductions in the workspace to board cells.
+     * @param space Workspace holding the frontier mapping and both deduction lists
+     * @param result Output safe and mine cells, sorted and unique; cells deduced both
+     *               ways are left out and counted in its conflict stat
+     */
+    static void collectCells(Workspace& space, Analysis& result);
+
+    /**
+     * Compute the probabilities of the board from the equations in the workspace.
+     * @param board The board the equations were built from
+     * @param space Workspace holding the frontier mapping and its equations
+     * @param result Output probabilities
+     */
+    static void computeProbabilities(const MSBoard& board, Workspace& space, Probabilities& result);
+
+    /**
+     * The probability tier of solveUntilStuck(): play every cell that is certain,
+     * or else open the cell least likely to be a mine.
+     * @param board Reference to the Minesweeper board to solve
+     * @param space Workspace holding the frontier mapping and its equations
+     * @param run The run, whose guesses are counted
+     * @return Number of cells opened or marked
+     */
+    static int playProbabilities(MSBoard& board, Workspace& space, RunResult& run);
+
+    /**
+     * Estimate the work of reducing the split components.
+     * @param components The components
+     * @return rows * cols * min(rows, cols), summed over components
+     */
+    static double eliminationCost(const std::vector<EquationComponent>& components);
+
+    /**
+     * Reduce each connected component to RREF and collect its deductions.
+     * Components large enough for parallel elimination are reduced one at a time with
+     * all threads; large sets of smaller components are solved concurrently on componentPool().
+     * @param engine The row reduction engine to use
+     * @param space Workspace holding the split components; its deductions receive the
+     *              result: all components in component order, over global variable indices
+     */
+    static void deduceFromComponents(RREFEngine engine, Workspace& space);
+
+    /**
+     * Get the shared pool used for per-component solving.
+     * @return The pool, sized to the hardware concurrency
      */
-    static bool hasBoardChanged(const std::vector<std::vector<int>>& old_state,
-                               const std::vector<std::vector<int>>& new_state);
+    static WorkStealingPool& componentPool();
 
     /**
-     * Determine whether to skip RREF computation for this iteration.
-     * @param iteration The current iteration number
-     * @return True if RREF should be skipped, false otherwise
+     * Reduce a single connected component to RREF with the selected engine.
+     * The exact engine reuses a thread-local elimination workspace.
+     * @param equations The component's equations, with local variable indices
+     * @param engine The row reduction engine to use
+     * @param threadCount Threads IntegerRREF may use for a large component, 0 for all
+     * @param reduced Output equations, with local variable indices; its storage is reused
      */
-    static bool shouldSkipRREF(int iteration);
+    static void reduceComponent(const EquationSystem& equations, RREFEngine engine,
+                                unsigned threadCount, EquationSystem& reduced);
 };
 
 #endif // MINESWEEPER_SOLVER_HPP
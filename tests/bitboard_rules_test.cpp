@@ -0,0 +1,118 @@
+#include <vector>
+#include "../src/minesweeper_class.hpp"
+#include "bitboard_rules.hpp"
+#include "solver_constants.hpp"
+#include "test_check.hpp"
+
+/**
+ * BitboardRules: soundness, fixpoint, resume() against run(), and a wrong flag.
+ */
+
+namespace {
+
+struct Around {
+    int flagged = 0;
+    int unrevealed = 0;
+};
+
+Around around(const BoardGrid& state, int cell) {
+    Around counts;
+    for (int offset : state.neighborOffsets()) {
+        counts.flagged += state[cell + offset] == SolverConstants::MARKED_MINE;
+        counts.unrevealed += state[cell + offset] == SolverConstants::UNREVEALED;
+    }
+    return counts;
+}
+
+void testSoundFixpoint() {
+    BitboardRules rules;
+    for (uint64_t seed = 1; seed <= 200; ++seed) {
+        MSBoard board(16, 30, 99, seed);
+        board.open(8, 15);
+        BitboardRules::Stats stats = rules.run(board);
+        CHECK(!stats.lost && !board.isLost());
+
+        // Every flag is a mine, and no revealed number still triggers a rule
+        const BoardGrid& state = board.revealedBoard;
+        int flags = 0;
+        for (int cell = 0; cell < static_cast<int>(state.size()); ++cell) {
+            if (state[cell] == SolverConstants::MARKED_MINE) {
+                CHECK(board.board[cell] == -1);
+                ++flags;
+            } else if (state[cell] >= 0) {
+                Around counts = around(state, cell);
+                if (counts.unrevealed == 0) continue;
+                CHECK(state[cell] != counts.flagged);
+                CHECK(state[cell] != counts.flagged + counts.unrevealed);
+            }
+        }
+        CHECK(flags == stats.mines && flags == board.flaggedCount());
+    }
+}
+
+void testResumeMatchesRun() {
+    // Opening a safe cell from outside between two calls: resume() must pick it up
+    BitboardRules resumed, reloaded;
+    for (uint64_t seed = 1; seed <= 100; ++seed) {
+        MSBoard a(16, 16, 40, seed), b(16, 16, 40, seed);
+        a.open(8, 8);
+        b.open(8, 8);
+        resumed.run(a);
+        reloaded.run(b);
+        for (int step = 0; step < 3 && !a.isSolved(); ++step) {
+            int cell = 0;
+            while (a.revealedBoard[cell] != SolverConstants::UNREVEALED || a.board[cell] == -1) ++cell;
+            int r = a.revealedBoard.row(cell), c = a.revealedBoard.col(cell);
+            a.open(r, c);
+            b.open(r, c);
+            BitboardRules::Stats x = resumed.resume(a);
+            BitboardRules::Stats y = reloaded.run(b);
+            CHECK(x.mines == y.mines && x.safe == y.safe);
+        }
+        for (int cell = 0; cell < static_cast<int>(a.revealedBoard.size()); ++cell) {
+            CHECK(a.revealedBoard[cell] == b.revealedBoard[cell]);
+        }
+    }
+}
+
+void testWrongFlagStops() {
+    // Flag safe cells next to a number until it looks satisfied, so that the
+    // rules deduce its real mine safe and open it. The run must stop there.
+    BitboardRules rules;
+    int exploded = 0;
+    for (uint64_t seed = 1; seed <= 100; ++seed) {
+        MSBoard board(9, 9, 10, seed);
+        board.open(4, 4);
+        const BoardGrid& state = board.revealedBoard;
+        bool flagged = false;
+        for (int cell = 0; cell < static_cast<int>(state.size()) && !flagged; ++cell) {
+            if (state[cell] <= 0) continue;
+            std::vector<int> safe;
+            int mines = 0;
+            for (int offset : state.neighborOffsets()) {
+                int neighbor = cell + offset;
+                if (state[neighbor] != SolverConstants::UNREVEALED) continue;
+                if (board.board[neighbor] == -1) ++mines;
+                else safe.push_back(neighbor);
+            }
+            if (mines == 0 || static_cast<int>(safe.size()) < state[cell]) continue;
+            for (int k = 0; k < state[cell]; ++k) board.markMine(state.row(safe[k]), state.col(safe[k]));
+            flagged = true;
+        }
+        if (!flagged) continue;
+
+        BitboardRules::Stats stats = rules.run(board);
+        CHECK(stats.lost == board.isLost());
+        exploded += stats.lost;
+    }
+    CHECK(exploded > 0);
+}
+
+} // namespace
+
+int main() {
+    testSoundFixpoint();
+    testResumeMatchesRun();
+    testWrongFlagStops();
+    return test::finish("bitboard_rules_test");
+}
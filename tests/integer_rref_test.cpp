@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+#include "integer_rref.hpp"
+#include "equation_system.hpp"
+#include "test_check.hpp"
+
+/**
+ * IntegerRREF against a reference Gauss-Jordan over rationals, and its BigInt
+ * fallback against its 64-bit path.
+ */
+
+namespace {
+
+using Matrix = std::vector<std::vector<int64_t>>;  // Augmented: the last column is the RHS
+
+EquationSystem toSystem(const Matrix& matrix, int variables) {
+    EquationSystem system(variables);
+    for (const auto& row : matrix) {
+        for (int c = 0; c < variables; ++c) {
+            if (row[c] != 0) system.addTerm(c, static_cast<int>(row[c]));
+        }
+        system.finishEquation(static_cast<int>(row[variables]));
+    }
+    return system;
+}
+
+Matrix toMatrix(const EquationSystem& system) {
+    Matrix matrix;
+    for (int i = 0; i < system.equationCount(); ++i) {
+        EquationSystem::Row row = system.equation(i);
+        std::vector<int64_t> dense(system.variableCount() + 1, 0);
+        for (int k = 0; k < row.size; ++k) {
+            dense[row.columns[k]] = row.coefficients[k];
+        }
+        dense[system.variableCount()] = row.rhs;
+        matrix.push_back(dense);
+    }
+    return matrix;
+}
+
+/**
+ * Reduced row echelon form by Gauss-Jordan over fractions, each nonzero row
+ * then scaled to integers with content 1 and a positive pivot. Only meant for
+ * the small 0/1 systems below, whose fractions fit in 64 bits.
+ */
+Matrix referenceRREF(const Matrix& input, int variables) {
+    struct Fraction {
+        int64_t num = 0, den = 1;
+    };
+    auto normalize = [](Fraction f) {
+        if (f.den < 0) { f.num = -f.num; f.den = -f.den; }
+        int64_t g = std::gcd(std::llabs(f.num), f.den);
+        if (g > 1) { f.num /= g; f.den /= g; }
+        return f;
+    };
+    auto sub = [&](Fraction a, Fraction b, Fraction factor) {  // a - factor * b
+        Fraction product = normalize({factor.num * b.num, factor.den * b.den});
+        return normalize({a.num * product.den - product.num * a.den, a.den * product.den});
+    };
+
+    std::vector<std::vector<Fraction>> m;
+    for (const auto& row : input) {
+        std::vector<Fraction> fractions;
+        for (int64_t value : row) fractions.push_back({value, 1});
+        m.push_back(fractions);
+    }
+    size_t pivot_row = 0;
+    for (int c = 0; c < variables && pivot_row < m.size(); ++c) {
+        size_t r = pivot_row;
+        while (r < m.size() && m[r][c].num == 0) ++r;
+        if (r == m.size()) continue;
+        std::swap(m[r], m[pivot_row]);
+        Fraction pivot = m[pivot_row][c];
+        for (auto& entry : m[pivot_row]) entry = normalize({entry.num * pivot.den, entry.den * pivot.num});
+        for (size_t other = 0; other < m.size(); ++other) {
+            if (other == pivot_row || m[other][c].num == 0) continue;
+            Fraction factor = m[other][c];
+            for (int k = 0; k <= variables; ++k) m[other][k] = sub(m[other][k], m[pivot_row][k], factor);
+        }
+        ++pivot_row;
+    }
+
+    // Rows past the pivots are 0 = c; the nonzero ones are kept, as contradictions
+    Matrix result;
+    for (size_t r = 0; r < m.size(); ++r) {
+        if (r >= pivot_row && m[r][variables].num == 0) continue;
+        int64_t scale = 1;
+        for (const auto& entry : m[r]) scale = std::lcm(scale, entry.den);
+        std::vector<int64_t> row;
+        int64_t content = 0;
+        for (const auto& entry : m[r]) {
+            row.push_back(entry.num * (scale / entry.den));
+            content = std::gcd(content, std::llabs(row.back()));
+        }
+        if (r >= pivot_row && row[variables] < 0) content = -content;
+        for (auto& value : row) value /= content;
+        result.push_back(row);
+    }
+    return result;
+}
+
+/**
+ * A sparse 0/1 system shaped like a frontier: each row covers a few nearby
+ * variables, with a right-hand side that a random layout satisfies.
+ */
+Matrix randomFrontier(test::Rng& rng, int variables, int equations) {
+    std::vector<int> layout(variables);
+    for (auto& mine : layout) mine = rng.below(3) == 0;
+    Matrix matrix;
+    for (int e = 0; e < equations; ++e) {
+        std::vector<int64_t> row(variables + 1, 0);
+        int start = static_cast<int>(rng.below(variables));
+        int width = std::min(variables, 2 + static_cast<int>(rng.below(4)));
+        for (int k = 0; k < width; ++k) {
+            int c = (start + k) % variables;
+            row[c] = 1;
+            row[variables] += layout[c];
+        }
+        matrix.push_back(row);
+    }
+    return matrix;
+}
+
+/**
+ * Replace the rows by combinations with large multipliers through unit
+ * triangular factors L * U. The row space, and so the RREF, is unchanged,
+ * but the entries are large enough that the fraction-free elimination
+ * mostly overflows 64 bits and has to restart with BigInt.
+ */
+Matrix scramble(test::Rng& rng, const Matrix& matrix) {
+    const size_t n = matrix.size();
+    auto combine = [&](const Matrix& rows, bool lower) {
+        Matrix out = rows;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                if (lower ? j >= i : j <= i) continue;
+                int64_t factor = static_cast<int64_t>(rng.below(2001)) - 1000;
+                for (size_t k = 0; k < rows[i].size(); ++k) out[i][k] += factor * rows[j][k];
+            }
+        }
+        return out;
+    };
+    // U first: row i takes multiples of the original rows after it; then L mixes the results
+    return combine(combine(matrix, false), true);
+}
+
+void testAgainstReference() {
+    test::Rng rng(1);
+    for (int round = 0; round < 500; ++round) {
+        int variables = 4 + static_cast<int>(rng.below(9));
+        int equations = 2 + static_cast<int>(rng.below(variables + 2));
+        Matrix matrix = randomFrontier(rng, variables, equations);
+        Matrix expected = referenceRREF(matrix, variables);
+        Matrix actual = toMatrix(IntegerRREF::compute(toSystem(matrix, variables), 1));
+        CHECK(actual == expected);
+    }
+}
+
+void testBigIntFallback() {
+    test::Rng rng(2);
+    for (int round = 0; round < 200; ++round) {
+        int variables = 6 + static_cast<int>(rng.below(6));
+        int equations = 4 + static_cast<int>(rng.below(6));
+        Matrix matrix = randomFrontier(rng, variables, equations);
+        Matrix scrambled = scramble(rng, matrix);
+        Matrix small = toMatrix(IntegerRREF::compute(toSystem(matrix, variables), 1));
+        Matrix large = toMatrix(IntegerRREF::compute(toSystem(scrambled, variables), 1));
+        CHECK(large == small);
+    }
+}
+
+void testKnownSolution() {
+    // Square invertible systems with coefficients near 1e8 and RHS A * x for
+    // a 0/1 vector x reduce to [I | x], on the BigInt path
+    test::Rng rng(3);
+    for (int round = 0; round < 50; ++round) {
+        const int n = 6;
+        Matrix matrix(n, std::vector<int64_t>(n + 1, 0));
+        std::vector<int64_t> x(n);
+        for (auto& value : x) value = static_cast<int64_t>(rng.below(2));
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) {
+                matrix[r][c] = 1 + static_cast<int64_t>(rng.below(100000000));
+                matrix[r][n] += matrix[r][c] * x[c];
+            }
+        }
+        // The RHS must fit in int: at most six terms below 1e8
+        Matrix expected(n, std::vector<int64_t>(n + 1, 0));
+        for (int r = 0; r < n; ++r) {
+            expected[r][r] = 1;
+            expected[r][n] = x[r];
+        }
+        CHECK(toMatrix(IntegerRREF::compute(toSystem(matrix, n), 1)) == expected);
+    }
+}
+
+void testDegenerateRows() {
+    // Duplicate, zero and contradictory rows
+    Matrix matrix = {
+        {1, 1, 0, 1},
+        {1, 1, 0, 1},
+        {0, 0, 0, 0},
+        {0, 1, 1, 2},
+    };
+    Matrix expected = referenceRREF(matrix, 3);
+    CHECK(expected.size() == 2);
+    CHECK(toMatrix(IntegerRREF::compute(toSystem(matrix, 3), 1)) == expected);
+
+    Matrix contradiction = {{1, 1, 1}, {1, 1, 2}};
+    Matrix reduced = toMatrix(IntegerRREF::compute(toSystem(contradiction, 2), 1));
+    CHECK(reduced == referenceRREF(contradiction, 2));
+    CHECK(reduced.size() == 2 && reduced[1] == (std::vector<int64_t>{0, 0, 1}));
+}
+
+void testReusedTeam() {
+    // Large enough for the parallel elimination; one workspace keeps its team
+    // while the thread count grows and shrinks between calls
+    test::Rng rng(4);
+    const int variables = 800, equations = 700;
+    CHECK(static_cast<size_t>(equations) * (variables + 1) >= IntegerRREF::PARALLEL_ELIMINATION_MIN_ENTRIES);
+    IntegerRREF::Workspace workspace;
+    for (int round = 0; round < 2; ++round) {
+        EquationSystem system = toSystem(randomFrontier(rng, variables, equations), variables);
+        Matrix expected = toMatrix(IntegerRREF::compute(system, 1));
+        for (unsigned threads : {3u, 1u, 4u, 2u}) {
+            EquationSystem reduced;
+            IntegerRREF::compute(system, reduced, workspace, threads);
+            CHECK(toMatrix(reduced) == expected);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    testAgainstReference();
+    testBigIntFallback();
+    testKnownSolution();
+    testDegenerateRows();
+    testReusedTeam();
+    return test::finish("integer_rref_test");
+}
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "../src/minesweeper_class.hpp"
+#include "test_check.hpp"
+
+/**
+ * Board generation and MSBoard::open edge cases.
+ */
+
+namespace {
+
+int countMines(const MSBoard& board) {
+    int mines = 0;
+    for (int r = 0; r < board.rows; ++r) {
+        for (int c = 0; c < board.cols; ++c) {
+            mines += board.board(r, c) == -1;
+        }
+    }
+    return mines;
+}
+
+int countUnrevealed(const MSBoard& board) {
+    int unrevealed = 0;
+    for (int r = 0; r < board.rows; ++r) {
+        for (int c = 0; c < board.cols; ++c) {
+            unrevealed += board.revealedBoard(r, c) == -1;
+        }
+    }
+    return unrevealed;
+}
+
+void testFirstClickIsSafe() {
+    for (uint64_t seed = 1; seed <= 200; ++seed) {
+        MSBoard board(9, 9, 10, seed);
+        int row = static_cast<int>(seed % 9), col = static_cast<int>((seed / 9) % 9);
+        CHECK(board.open(row, col) == MSBoard::OpenResult::Safe);
+        CHECK(countMines(board) == 10);
+        CHECK(board.mines == 10);
+        for (int r = row - 1; r <= row + 1; ++r) {
+            for (int c = col - 1; c <= col + 1; ++c) {
+                if (r >= 0 && r < 9 && c >= 0 && c < 9) CHECK(board.board(r, c) != -1);
+            }
+        }
+        // The first click is a zero, so it opens at least its 3x3
+        CHECK(board.revealedBoard(row, col) == 0);
+    }
+}
+
+void testNumbersMatchMines() {
+    MSBoard board(16, 30, 99, 5);
+    board.open(8, 15);
+    for (int r = 0; r < 16; ++r) {
+        for (int c = 0; c < 30; ++c) {
+            if (board.board(r, c) == -1) continue;
+            int around = 0;
+            for (int dr = -1; dr <= 1; ++dr) {
+                for (int dc = -1; dc <= 1; ++dc) {
+                    int rr = r + dr, cc = c + dc;
+                    if ((dr || dc) && rr >= 0 && rr < 16 && cc >= 0 && cc < 30) around += board.board(rr, cc) == -1;
+                }
+            }
+            CHECK(board.board(r, c) == around);
+        }
+    }
+}
+
+void testSeedAndReset() {
+    MSBoard first(16, 16, 40, 11), second(16, 16, 40, 11);
+    first.open(4, 4);
+    second.open(4, 4);
+    const int cells = static_cast<int>(first.board.size());
+    std::vector<int> layout(cells);
+    for (int i = 0; i < cells; ++i) {
+        CHECK(first.board[i] == second.board[i]);
+        layout[i] = first.board[i];
+    }
+
+    // reset() with the same seed replays the same game in place
+    first.markMine(0, 0);
+    first.reset(11);
+    CHECK(!first.started && !first.isLost());
+    CHECK(first.unrevealedCount() == 256 && first.flaggedCount() == 0);
+    CHECK(first.changedCells().empty());
+    first.open(4, 4);
+    for (int i = 0; i < cells; ++i) CHECK(first.board[i] == layout[i]);
+}
+
+void testFloodFill() {
+    for (uint64_t seed = 1; seed <= 50; ++seed) {
+        MSBoard board(16, 30, 99, seed);
+        board.open(8, 15);
+        const BoardGrid& state = board.revealedBoard;
+
+        // Exactly the cells the log shows, each revealed with its true value
+        std::vector<int> revealed = board.revealedCells();
+        std::vector<int> logged = board.changedCells();
+        std::sort(revealed.begin(), revealed.end());
+        std::sort(logged.begin(), logged.end());
+        CHECK(revealed == logged);
+        CHECK(std::adjacent_find(revealed.begin(), revealed.end()) == revealed.end());
+        for (int cell : revealed) CHECK(state[cell] == board.board[cell]);
+
+        // Every revealed zero has all its neighbours revealed
+        for (int cell : revealed) {
+            if (state[cell] != 0) continue;
+            for (int offset : state.neighborOffsets()) CHECK(state[cell + offset] != -1);
+        }
+        CHECK(board.unrevealedCount() == countUnrevealed(board));
+    }
+}
+
+void testOpenAgainAndMark() {
+    MSBoard board(9, 9, 10, 3);
+    board.open(4, 4);
+    int unrevealed = board.unrevealedCount();
+    size_t logged = board.changedCells().size();
+
+    // Opening a revealed cell changes nothing
+    CHECK(board.open(4, 4) == MSBoard::OpenResult::Safe);
+    CHECK(board.revealedCells().empty());
+    CHECK(board.changedCells().size() == logged);
+
+    // Marking counts once, and only on unrevealed cells
+    int r = 0, c = 0;
+    while (board.revealedBoard(r, c) != -1) {
+        if (++c == 9) { c = 0; ++r; }
+    }
+    board.markMine(r, c);
+    board.markMine(r, c);
+    board.markMine(4, 4);
+    CHECK(board.flaggedCount() == 1);
+    CHECK(board.unrevealedCount() == unrevealed - 1);
+    CHECK(board.revealedBoard(4, 4) == 0);
+}
+
+void testOpenMine() {
+    MSBoard board(9, 9, 10, 4);
+    board.open(4, 4);
+    CHECK(!board.revealedCells().empty());
+    int r = 0, c = 0;
+    while (board.board(r, c) != -1) {
+        if (++c == 9) { c = 0; ++r; }
+    }
+    int unrevealed = board.unrevealedCount();
+    CHECK(board.open(r, c) == MSBoard::OpenResult::Mine);
+    CHECK(board.isLost());
+    CHECK(board.revealedCells().empty());
+    CHECK(board.revealedBoard(r, c) == -1);
+    CHECK(board.unrevealedCount() == unrevealed);
+}
+
+void testTooManyMines() {
+    // A corner click leaves 21 of the 25 cells as candidates, the centre 16
+    MSBoard board(5, 5, 30, 1);
+    CHECK(board.mines == 30);
+    board.open(0, 0);
+    CHECK(board.mines == 21);
+    CHECK(countMines(board) == 21);
+
+    board.reset(2);
+    CHECK(board.mines == 30);
+    board.open(2, 2);
+    CHECK(board.mines == 16);
+    CHECK(countMines(board) == 16);
+}
+
+void testSolvedWithoutMarks() {
+    // A 7x7 board with a centre click leaves exactly 40 candidates: the two
+    // outer rings are all mines and the corners touch no open cell
+    MSBoard board(7, 7, 40, 1);
+    CHECK(!board.isSolved());
+    board.open(3, 3);
+    CHECK(board.unrevealedCount() == 40);
+    CHECK(board.isSolved());
+
+    // Marks do not matter, and a wrong mark on an open cell is ignored
+    board.markMine(1, 1);
+    board.markMine(2, 2);
+    CHECK(board.flaggedCount() == 1);
+    CHECK(board.isSolved());
+
+    // Not solved while any safe cell is closed; a lost board never is
+    MSBoard partial(9, 9, 10, 3);
+    partial.open(4, 4);
+    for (int r = 0; r < 9; ++r) {
+        for (int c = 0; c < 9; ++c) {
+            if (partial.board(r, c) == -1 || partial.revealedBoard(r, c) != -1) continue;
+            CHECK(!partial.isSolved());
+            partial.open(r, c);
+        }
+    }
+    CHECK(partial.unrevealedCount() == 10);
+    CHECK(partial.isSolved());
+    partial.reset(3);
+    partial.open(4, 4);
+    for (int r = 0; r < 9; ++r) {
+        for (int c = 0; c < 9; ++c) {
+            if (partial.board(r, c) == -1 && !partial.isLost()) partial.open(r, c);
+        }
+    }
+    CHECK(partial.isLost() && !partial.isSolved());
+}
+
+} // namespace
+
+int main() {
+    testFirstClickIsSafe();
+    testNumbersMatchMines();
+    testSeedAndReset();
+    testFloodFill();
+    testOpenAgainAndMark();
+    testOpenMine();
+    testTooManyMines();
+    testSolvedWithoutMarks();
+    return test::finish("msboard_test");
+}
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <set>
+#include <vector>
+#include "presolve.hpp"
+#include "equation_system.hpp"
+#include "test_check.hpp"
+
+/**
+ * Presolve on hand-made patterns and, against brute force, on random systems.
+ */
+
+namespace {
+
+struct Equation {
+    std::vector<int> variables;  // Ascending
+    int rhs;
+};
+
+EquationSystem toSystem(const std::vector<Equation>& equations, int variables) {
+    EquationSystem system(variables);
+    for (const auto& equation : equations) {
+        for (int variable : equation.variables) system.addTerm(variable, 1);
+        system.finishEquation(equation.rhs);
+    }
+    return system;
+}
+
+bool satisfies(const EquationSystem& system, unsigned layout) {
+    for (int i = 0; i < system.equationCount(); ++i) {
+        EquationSystem::Row row = system.equation(i);
+        int sum = 0;
+        for (int k = 0; k < row.size; ++k) sum += row.coefficients[k] * ((layout >> row.columns[k]) & 1);
+        if (sum != row.rhs) return false;
+    }
+    return true;
+}
+
+bool satisfies(const std::vector<RREFProcessor::Deduction>& deductions, unsigned layout) {
+    for (const auto& deduction : deductions) {
+        if (((layout >> deduction.variable) & 1) != static_cast<unsigned>(deduction.is_mine)) return false;
+    }
+    return true;
+}
+
+bool deduced(const std::vector<RREFProcessor::Deduction>& deductions, int variable, bool is_mine) {
+    return std::any_of(deductions.begin(), deductions.end(), [&](const RREFProcessor::Deduction& d) {
+        return d.variable == variable && d.is_mine == is_mine;
+    });
+}
+
+void testOneTwoOne() {
+    // A 1-2-1 against a wall: the outer ones each see two of the three cells
+    Presolve presolve;
+    EquationSystem reduced;
+    std::vector<RREFProcessor::Deduction> deductions;
+    Presolve::Stats stats = presolve.run(toSystem({{{0, 1}, 1}, {{0, 1, 2}, 2}, {{1, 2}, 1}}, 3), reduced, deductions);
+    CHECK(stats.subset_subtractions >= 2);
+    CHECK(deductions.size() == 3);
+    CHECK(deduced(deductions, 0, true));
+    CHECK(deduced(deductions, 1, false));
+    CHECK(deduced(deductions, 2, true));
+    CHECK(reduced.equationCount() == 0);
+}
+
+void testFixedRows() {
+    // rhs 0 clears a row, rhs == size fills one, and substituting them fixes x5
+    Presolve presolve;
+    EquationSystem reduced;
+    std::vector<RREFProcessor::Deduction> deductions;
+    Presolve::Stats stats = presolve.run(toSystem({{{0, 1, 2}, 0}, {{3, 4}, 2}, {{2, 5}, 1}}, 6), reduced, deductions);
+    CHECK(stats.fixed_variables == 6);
+    CHECK(deductions.size() == 6);
+    for (int variable : {0, 1, 2}) CHECK(deduced(deductions, variable, false));
+    for (int variable : {3, 4, 5}) CHECK(deduced(deductions, variable, true));
+    CHECK(reduced.equationCount() == 0);
+}
+
+void testDuplicateAndSatisfiedRows() {
+    Presolve presolve;
+    EquationSystem reduced;
+    std::vector<RREFProcessor::Deduction> deductions;
+
+    // The second x0 + x1 + x2 = 1 adds nothing
+    Presolve::Stats stats = presolve.run(
+        toSystem({{{0, 1, 2}, 1}, {{0, 1, 2}, 1}, {{2, 3, 4}, 1}, {{3, 4, 5}, 1}}, 6), reduced, deductions);
+    CHECK(stats.duplicate_rows == 1);
+    CHECK(deductions.empty());
+
+    // Once x0 = 1 and x1 = 0 are fixed, x0 + x1 = 1 has no unknowns left
+    deductions.clear();
+    stats = presolve.run(toSystem({{{0}, 1}, {{1}, 0}, {{0, 1}, 1}, {{1, 2, 3}, 1}}, 4), reduced, deductions);
+    CHECK(stats.satisfied_rows >= 1);
+    CHECK(deduced(deductions, 0, true));
+    CHECK(deduced(deductions, 1, false));
+}
+
+void testNonUnitCopiedThrough() {
+    Presolve presolve;
+    EquationSystem system(3), reduced;
+    std::vector<RREFProcessor::Deduction> deductions;
+    system.addTerm(0, 2);
+    system.addTerm(1, 1);
+    system.finishEquation(2);
+    system.addTerm(1, 1);
+    system.addTerm(2, 1);
+    system.finishEquation(0);
+    presolve.run(system, reduced, deductions);
+    CHECK(deductions.empty());
+    CHECK(reduced.equationCount() == 2);
+    CHECK(reduced.nonZeroCount() == system.nonZeroCount());
+}
+
+void testRecoverDroppedRows() {
+    // A chain x0 + x1 = 1, x1 + x2 = 1, x2 + x3 = 1 is dropped row by row as its
+    // ends become singletons; knowing x2 from elsewhere settles the whole chain
+    Presolve presolve;
+    EquationSystem reduced;
+    std::vector<RREFProcessor::Deduction> deductions;
+    Presolve::Stats stats = presolve.run(toSystem({{{0, 1}, 1}, {{1, 2}, 1}, {{2, 3}, 1}}, 4), reduced, deductions);
+    CHECK(stats.singleton_rows == 3);
+    CHECK(reduced.equationCount() == 0);
+    CHECK(deductions.empty());
+
+    deductions.push_back({2, true});
+    CHECK(presolve.recover(deductions) == 3);
+    CHECK(deductions.size() == 4);
+    CHECK(deduced(deductions, 0, true));
+    CHECK(deduced(deductions, 1, false));
+    CHECK(deduced(deductions, 3, false));
+
+    // Without the rest of a row nothing is settled
+    deductions.clear();
+    presolve.run(toSystem({{{0, 1}, 1}, {{1, 2}, 1}, {{2, 3}, 1}}, 4), reduced, deductions);
+    CHECK(presolve.recover(deductions) == 0);
+}
+
+void testAgainstBruteForce() {
+    // Every layout of the original system must survive presolve, and every layout
+    // presolve allows must extend to one of the original on the variables it kept
+    test::Rng rng(7);
+    Presolve presolve;
+    EquationSystem reduced;
+    std::vector<RREFProcessor::Deduction> deductions;
+    int recovered = 0;
+    for (int round = 0; round < 300; ++round) {
+        const int variables = 4 + static_cast<int>(rng.below(7));
+        unsigned truth = 0;
+        for (int v = 0; v < variables; ++v) truth |= static_cast<unsigned>(rng.below(3) == 0) << v;
+        std::vector<Equation> equations;
+        int count = 2 + static_cast<int>(rng.below(variables));
+        for (int e = 0; e < count; ++e) {
+            Equation equation{{}, 0};
+            int start = static_cast<int>(rng.below(variables));
+            int width = std::min(variables - start, 1 + static_cast<int>(rng.below(4)));
+            for (int v = start; v < start + width; ++v) {
+                equation.variables.push_back(v);
+                equation.rhs += (truth >> v) & 1;
+            }
+            equations.push_back(equation);
+        }
+        EquationSystem system = toSystem(equations, variables);
+        deductions.clear();
+        presolve.run(system, reduced, deductions);
+
+        unsigned kept = 0;  // Variables presolve still constrains or fixed
+        for (int i = 0; i < reduced.equationCount(); ++i) {
+            EquationSystem::Row row = reduced.equation(i);
+            for (int k = 0; k < row.size; ++k) kept |= 1u << row.columns[k];
+        }
+        for (const auto& deduction : deductions) kept |= 1u << deduction.variable;
+
+        std::set<unsigned> projections;
+        bool sound = true;
+        for (unsigned layout = 0; layout < (1u << variables); ++layout) {
+            if (!satisfies(system, layout)) continue;
+            projections.insert(layout & kept);
+            sound = sound && satisfies(reduced, layout) && satisfies(deductions, layout);
+        }
+        bool complete = true;
+        for (unsigned layout = 0; layout < (1u << variables); ++layout) {
+            if ((layout & ~kept) != 0) continue;
+            if (satisfies(reduced, layout) && satisfies(deductions, layout)) {
+                complete = complete && projections.count(layout) > 0;
+            }
+        }
+        CHECK(sound);
+        CHECK(complete);
+
+        // Told the true values of some variables, recover() settles only true values
+        std::vector<RREFProcessor::Deduction> known = deductions;
+        for (int v = 0; v < variables; ++v) {
+            if (rng.below(2) == 0) known.push_back({v, ((truth >> v) & 1) != 0});
+        }
+        recovered += presolve.recover(known);
+        CHECK(satisfies(known, truth));
+    }
+    CHECK(recovered > 0);
+}
+
+} // namespace
+
+int main() {
+    testOneTwoOne();
+    testFixedRows();
+    testDuplicateAndSatisfiedRows();
+    testNonUnitCopiedThrough();
+    testRecoverDroppedRows();
+    testAgainstBruteForce();
+    return test::finish("presolve_test");
+}
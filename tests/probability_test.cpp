@@ -0,0 +1,154 @@
+#include <cmath>
+#include <vector>
+#include "../src/minesweeper_class.hpp"
+#include "../src/minesweeper_solver.hpp"
+#include "mine_probability.hpp"
+#include "solver_constants.hpp"
+#include "test_check.hpp"
+
+/**
+ * Exact mine probabilities against brute-force enumeration of every layout.
+ */
+
+namespace {
+
+constexpr int MAX_ENUMERATED_CELLS = 20;
+constexpr double TOLERANCE = 1e-9;
+
+/**
+ * Probability of each unrevealed cell from every placement of the unmarked
+ * mines that agrees with all revealed numbers.
+ * @return False if the position has too many unrevealed cells to enumerate
+ */
+bool bruteForce(const MSBoard& board, std::vector<int>& cells, std::vector<double>& probability) {
+    const BoardGrid& state = board.revealedBoard;
+    cells.clear();
+    for (int i = 0; i < static_cast<int>(state.size()); ++i) {
+        if (state[i] == SolverConstants::UNREVEALED) cells.push_back(i);
+    }
+    const int n = static_cast<int>(cells.size());
+    const int remaining = board.mines - board.flaggedCount();
+    if (n > MAX_ENUMERATED_CELLS) return false;
+
+    std::vector<int> layout(state.size(), 0);
+    std::vector<double> hits(n, 0);
+    double total = 0;
+    for (unsigned mask = 0; mask < (1u << n); ++mask) {
+        if (__builtin_popcount(mask) != remaining) continue;
+        for (int k = 0; k < n; ++k) layout[cells[k]] = (mask >> k) & 1;
+        bool fits = true;
+        for (int i = 0; i < static_cast<int>(state.size()) && fits; ++i) {
+            if (state[i] < 0) continue;
+            int around = 0;
+            for (int offset : state.neighborOffsets()) {
+                int neighbor = i + offset;
+                around += state[neighbor] == SolverConstants::MARKED_MINE ||
+                          (state[neighbor] == SolverConstants::UNREVEALED && layout[neighbor]);
+            }
+            fits = around == state[i];
+        }
+        if (!fits) continue;
+        total += 1;
+        for (int k = 0; k < n; ++k) hits[k] += (mask >> k) & 1;
+    }
+    probability.assign(n, 0);
+    for (int k = 0; k < n; ++k) probability[k] = hits[k] / total;
+    return true;
+}
+
+double probabilityOf(const MinesweeperSolver::Probabilities& result, int cell) {
+    for (size_t v = 0; v < result.cells.size(); ++v) {
+        if (result.cells[v] == cell) return result.mine[v];
+    }
+    return result.interior;
+}
+
+int checkSuite(int rows, int cols, int mines, int games) {
+    int checked = 0;
+    std::vector<int> cells;
+    std::vector<double> expected;
+    MinesweeperSolver::Probabilities result;
+    for (int game = 1; game <= games; ++game) {
+        MSBoard board(rows, cols, mines, game);
+        board.open(rows / 2, cols / 2);
+        MinesweeperSolver::solveUntilStuck(board);
+        if (board.isSolved() || !bruteForce(board, cells, expected)) continue;
+
+        MinesweeperSolver::probabilities(board, result);
+        CHECK(result.stats.exact && result.stats.feasible);
+        double sum = result.interior * result.interior_cells;
+        for (size_t k = 0; k < cells.size(); ++k) {
+            CHECK(std::fabs(probabilityOf(result, cells[k]) - expected[k]) < TOLERANCE);
+        }
+        for (double p : result.mine) sum += p;
+        CHECK(std::fabs(sum - (board.mines - board.flaggedCount())) < TOLERANCE);
+
+        // A second call finds every component in the cache and gives the same answer
+        MinesweeperSolver::Probabilities again;
+        MinesweeperSolver::probabilities(board, again);
+        CHECK(again.stats.counted == 0);
+        CHECK(again.mine == result.mine && again.interior == result.interior);
+        ++checked;
+    }
+    return checked;
+}
+
+void testAgainstBruteForce() {
+    // Small boards leave stuck positions with few enough unrevealed cells
+    CHECK(checkSuite(6, 6, 8, 300) > 50);
+    CHECK(checkSuite(5, 7, 9, 300) > 50);
+}
+
+void testFullBoard() {
+    // More mines than fit: every cell left after the first click is a mine
+    MSBoard board(5, 5, 30, 1);
+    board.open(2, 2);
+    MinesweeperSolver::Probabilities result;
+    MinesweeperSolver::probabilities(board, result);
+    CHECK(result.stats.feasible);
+    for (double p : result.mine) CHECK(std::fabs(p - 1) < TOLERANCE);
+}
+
+void testLargeInterior() {
+    // A long chain x0 + x1 = 1, x1 + x2 = 1, ... with its two alternating layouts,
+    // a separate 50/50 pair, and far more mines left than the frontier can take.
+    // The mine counts the frontier cannot reach have binomial weights far above
+    // the reachable ones, which must not overflow into the result.
+    const int chain = 3000;
+    std::vector<EquationComponent> components(2);
+    components[0].equations = EquationSystem(chain);
+    for (int v = 0; v + 1 < chain; ++v) {
+        components[0].equations.addTerm(v, 1);
+        components[0].equations.addTerm(v + 1, 1);
+        components[0].equations.finishEquation(1);
+        components[0].variables.push_back(v);
+    }
+    components[0].variables.push_back(chain - 1);
+    components[1].equations = EquationSystem(2);
+    components[1].equations.addTerm(0, 1);
+    components[1].equations.addTerm(1, 1);
+    components[1].equations.finishEquation(1);
+    components[1].variables = {chain, chain + 1};
+
+    const int interiorCells = 10000;
+    const int frontierMines = chain / 2 + 1;
+    MineProbability probability;
+    std::vector<double> mine;
+    double interior = 0;
+    MineProbability::Stats stats = probability.compute(components, chain + 2, interiorCells,
+                                                       frontierMines + 2003, nullptr, mine, interior);
+    CHECK(stats.exact && stats.feasible);
+    CHECK(mine.size() == static_cast<size_t>(chain + 2));
+    for (double p : mine) CHECK(std::isfinite(p) && std::fabs(p - 0.5) < TOLERANCE);
+    CHECK(std::fabs(interior - 2003.0 / interiorCells) < TOLERANCE);
+}
+
+} // namespace
+
+int main() {
+    MinesweeperSolver::setSerial(true);
+    testAgainstBruteForce();
+    testFullBoard();
+    testLargeInterior();
+    return test::finish("probability_test");
+}
@@ -0,0 +1,109 @@
+#include <vector>
+#include "../src/minesweeper_class.hpp"
+#include "../src/minesweeper_solver.hpp"
+#include "solver_constants.hpp"
+#include "test_check.hpp"
+
+/**
+ * solveUntilStuck(): stop reasons, step budgets, and that equations rebuilt
+ * every round lose nothing against one long run.
+ */
+
+namespace {
+
+using Stop = MinesweeperSolver::RunResult::Stop;
+
+bool flagsAreMines(const MSBoard& board) {
+    for (int cell = 0; cell < static_cast<int>(board.revealedBoard.size()); ++cell) {
+        if (board.revealedBoard[cell] == SolverConstants::MARKED_MINE && board.board[cell] != -1) return false;
+    }
+    return true;
+}
+
+void testCertainRun() {
+    for (uint64_t seed = 1; seed <= 100; ++seed) {
+        MSBoard board(16, 30, 99, seed);
+        board.open(8, 15);
+        MinesweeperSolver::RunResult result = MinesweeperSolver::solveUntilStuck(board);
+        CHECK(result.stop == Stop::Solved || result.stop == Stop::Stuck);
+        CHECK(result.guesses == 0 && !board.isLost());
+        CHECK((result.stop == Stop::Solved) == board.isSolved());
+        CHECK(flagsAreMines(board));
+        if (result.stop == Stop::Stuck) {
+            // Stuck means the linear algebra has nothing left either
+            MinesweeperSolver::Analysis analysis = MinesweeperSolver::analyze(board.revealedBoard);
+            CHECK(analysis.safe.empty() && analysis.mines.empty());
+        }
+    }
+}
+
+void testStepBudget() {
+    // One step at a time must end on the same board as one unbounded run
+    MinesweeperSolver::Budget budget;
+    budget.max_steps = 1;
+    int budgetStops = 0;
+    for (uint64_t seed = 1; seed <= 50; ++seed) {
+        MSBoard stepped(16, 16, 40, seed), whole(16, 16, 40, seed);
+        stepped.open(8, 8);
+        whole.open(8, 8);
+        MinesweeperSolver::RunResult result;
+        int steps = 0;
+        do {
+            result = MinesweeperSolver::solveUntilStuck(stepped, budget);
+            CHECK(result.steps <= 1);
+            budgetStops += result.stop == Stop::Budget;
+            steps += result.steps;
+        } while (result.stop == Stop::Budget && steps < 10000);
+
+        MinesweeperSolver::RunResult once = MinesweeperSolver::solveUntilStuck(whole);
+        CHECK(result.stop == once.stop);
+        for (int cell = 0; cell < static_cast<int>(whole.revealedBoard.size()); ++cell) {
+            CHECK(stepped.revealedBoard[cell] == whole.revealedBoard[cell]);
+        }
+    }
+    CHECK(budgetStops > 0);
+}
+
+void testGuessing() {
+    MinesweeperSolver::Budget budget;
+    budget.guess = true;
+    int lost = 0;
+    for (uint64_t seed = 1; seed <= 50; ++seed) {
+        MSBoard board(16, 30, 99, seed);
+        board.open(8, 15);
+        MinesweeperSolver::RunResult result = MinesweeperSolver::solveUntilStuck(board, budget);
+        CHECK(result.stop == Stop::Solved || result.stop == Stop::Lost);
+        CHECK((result.stop == Stop::Lost) == board.isLost());
+        CHECK((result.stop == Stop::Solved) == board.isSolved());
+        lost += board.isLost();
+
+        // A lost board stays lost without another step
+        if (board.isLost()) {
+            MinesweeperSolver::RunResult again = MinesweeperSolver::solveUntilStuck(board, budget);
+            CHECK(again.stop == Stop::Lost && again.steps == 0);
+        }
+    }
+    CHECK(lost > 0);
+}
+
+void testSolvedWithUnmarkedMines() {
+    // A 7x7 board with a centre click: the two outer rings are all mines and
+    // every safe cell opens at once. The corner mines touch no number, so no
+    // tier can mark them, yet the run is solved rather than stuck
+    MSBoard board(7, 7, 40, 1);
+    board.open(3, 3);
+    MinesweeperSolver::RunResult result = MinesweeperSolver::solveUntilStuck(board);
+    CHECK(result.stop == Stop::Solved);
+    CHECK(board.isSolved() && flagsAreMines(board));
+    CHECK(board.revealedBoard(0, 0) == -1 && board.flaggedCount() < 40);
+}
+
+} // namespace
+
+int main() {
+    testCertainRun();
+    testStepBudget();
+    testGuessing();
+    testSolvedWithUnmarkedMines();
+    return test::finish("solve_until_stuck_test");
+}
@@ -0,0 +1,71 @@
+#ifndef TEST_CHECK_HPP
+#define TEST_CHECK_HPP
+
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * Minimal checking for the test programs under tests/.
+ *
+ * A failed CHECK prints its location and expression and the program carries
+ * on, so one run reports every failure; finish() prints the summary and gives
+ * main() its exit status.
+ */
+namespace test {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+/**
+ * Report the result of a test program.
+ * @param name Name printed in the summary line
+ * @return Exit status for main(): 0 if every check passed
+ */
+inline int finish(const char* name) {
+    if (failures() == 0) {
+        std::printf("%s: all checks passed\n", name);
+        return 0;
+    }
+    std::printf("%s: %d checks failed\n", name, failures());
+    return 1;
+}
+
+/**
+ * Small deterministic generator (splitmix64) so that test inputs do not
+ * depend on the library under test or on the standard library's distributions.
+ */
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @return A value in [0, bound); the modulo bias is irrelevant for tests
+     */
+    uint64_t below(uint64_t bound) {
+        return next() % bound;
+    }
+
+private:
+    uint64_t state;
+};
+
+} // namespace test
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);      \
+            ++test::failures();                                                            \
+        }                                                                                  \
+    } while (0)
+
+#endif // TEST_CHECK_HPP